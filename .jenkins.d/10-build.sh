@@ -1,10 +1,13 @@
 #!/usr/bin/env bash
 set -exo pipefail
 
-# Build in debug mode
-./waf --color=yes configure --debug
+# Build in debug mode with tests
+./waf --color=yes configure --debug --with-tests
 ./waf --color=yes build
 
+# Run the unit tests
+./build/unit-tests
+
 # Cleanup
 ./waf --color=yes distclean
 
@@ -0,0 +1,368 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_BATCHING_TRANSPORT_HPP
+#define NDNTG_BATCHING_TRANSPORT_HPP
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+#include <ndn-cxx/transport/transport.hpp>
+#include <ndn-cxx/util/exception.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
+
+namespace ndntg {
+
+struct BatchingOptions
+{
+  /// flush as soon as this many bytes are queued; zero disables batching
+  std::size_t maxBytes = 0;
+  /// flush at most this long after the first queued packet; zero flushes at the end of
+  /// the current event loop iteration
+  std::chrono::microseconds maxDelay{0};
+
+  bool
+  isEnabled() const
+  {
+    return maxBytes > 0;
+  }
+};
+
+struct BatchingCounters
+{
+  uint64_t nBatches = 0;
+  uint64_t nPackets = 0;
+  uint64_t nBytes = 0;
+
+  BatchingCounters&
+  operator+=(const BatchingCounters& other)
+  {
+    nBatches += other.nBatches;
+    nPackets += other.nPackets;
+    nBytes += other.nBytes;
+    return *this;
+  }
+};
+
+/**
+ * @brief Transport that coalesces outgoing packets into batched socket writes.
+ *
+ * ndn-cxx stream transports issue one async_write per packet. Here, the packets sent during one
+ * event loop iteration (or within BatchingOptions::maxDelay) are queued and written together
+ * with one gather write, which asio turns into writev() calls of up to 64 packets each.
+ * While a write is in progress, new packets are queued for the next one.
+ */
+class BatchingTransport : public ndn::Transport
+{
+public:
+  const BatchingCounters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
+protected:
+  BatchingCounters m_counters;
+};
+
+/**
+ * @brief BatchingTransport over a stream socket, with @p Protocol being
+ *        boost::asio::local::stream_protocol or boost::asio::ip::tcp.
+ */
+template<typename Protocol>
+class StreamBatchingTransport : public BatchingTransport,
+                                public std::enable_shared_from_this<StreamBatchingTransport<Protocol>>
+{
+public:
+  StreamBatchingTransport(typename Protocol::endpoint endpoint, BatchingOptions options)
+    : m_endpoint(std::move(endpoint))
+    , m_options(options)
+  {
+  }
+
+  void
+  connect(boost::asio::io_context& ioCtx, ReceiveCallback receiveCallback) override
+  {
+    if (m_socket == nullptr) {
+      m_socket = std::make_unique<typename Protocol::socket>(ioCtx);
+      m_flushTimer = std::make_unique<boost::asio::steady_timer>(ioCtx);
+    }
+    Transport::connect(ioCtx, std::move(receiveCallback));
+
+    if (m_isConnecting || m_isConnected) {
+      return;
+    }
+    m_isConnecting = true;
+    m_socket->async_connect(m_endpoint, [self = this->shared_from_this()] (const auto& error) {
+      self->onConnected(error);
+    });
+  }
+
+  void
+  close() override
+  {
+    m_isConnecting = false;
+    m_isConnected = false;
+    m_isReceiving = false;
+    m_isReadPending = false;
+    m_isWriting = false;
+    m_isFlushScheduled = false;
+    m_wantCancel = false;
+
+    if (m_socket != nullptr) {
+      boost::system::error_code error; // ignored
+      m_socket->cancel(error);
+      m_socket->shutdown(Protocol::socket::shutdown_both, error);
+      m_socket->close(error);
+    }
+    if (m_flushTimer != nullptr) {
+      m_flushTimer->cancel();
+    }
+
+    // m_inFlight is released by the aborted write handler
+    m_pending.clear();
+    m_pendingBytes = 0;
+    m_inputSize = 0;
+  }
+
+  void
+  pause() override
+  {
+    if (!m_isReceiving) {
+      return;
+    }
+    m_isReceiving = false;
+    // cancelling would also abort a write in progress, so wait for it to complete
+    if (m_isWriting) {
+      m_wantCancel = true;
+    }
+    else if (m_isReadPending) {
+      m_socket->cancel();
+    }
+  }
+
+  void
+  resume() override
+  {
+    if (!m_isConnected || m_isReceiving) {
+      return;
+    }
+    m_isReceiving = true;
+    m_wantCancel = false;
+    if (!m_isReadPending) {
+      asyncReceive();
+    }
+  }
+
+  void
+  send(const ndn::Block& wire) override
+  {
+    m_pending.push_back(wire);
+    m_pendingBytes += wire.size();
+
+    // packets queued while connecting or writing are flushed when that completes
+    if (!m_isConnected || m_isWriting) {
+      return;
+    }
+    if (m_pendingBytes >= m_options.maxBytes) {
+      flush();
+    }
+    else {
+      scheduleFlush();
+    }
+  }
+
+private:
+  void
+  onConnected(const boost::system::error_code& error)
+  {
+    m_isConnecting = false;
+    if (error) {
+      if (error == boost::asio::error::operation_aborted) {
+        return;
+      }
+      close();
+      NDN_THROW(Error(error, "error while connecting to the forwarder"));
+    }
+
+    m_isConnected = true;
+    resume();
+    flush();
+  }
+
+  void
+  scheduleFlush()
+  {
+    if (m_isFlushScheduled) {
+      return;
+    }
+    m_isFlushScheduled = true;
+
+    auto self = this->shared_from_this();
+    if (m_options.maxDelay > std::chrono::microseconds::zero()) {
+      m_flushTimer->expires_after(m_options.maxDelay);
+      m_flushTimer->async_wait([self] (const boost::system::error_code& error) {
+        if (!error) {
+          self->m_isFlushScheduled = false;
+          self->flush();
+        }
+      });
+    }
+    else {
+      // runs after the handlers that are already queued, i.e. at the end of this loop iteration
+      boost::asio::post(*m_ioCtx, [self] {
+        self->m_isFlushScheduled = false;
+        self->flush();
+      });
+    }
+  }
+
+  void
+  flush()
+  {
+    if (!m_isConnected || m_isWriting || m_pending.empty()) {
+      return;
+    }
+
+    m_inFlight.swap(m_pending);
+    m_buffers.clear();
+    for (const auto& block : m_inFlight) {
+      m_buffers.emplace_back(block.data(), block.size());
+    }
+    m_counters.nBatches++;
+    m_counters.nPackets += m_inFlight.size();
+    m_counters.nBytes += m_pendingBytes;
+    m_pendingBytes = 0;
+
+    m_isWriting = true;
+    boost::asio::async_write(*m_socket, m_buffers,
+      [self = this->shared_from_this()] (const boost::system::error_code& error, std::size_t) {
+        self->onWritten(error);
+      });
+  }
+
+  void
+  onWritten(const boost::system::error_code& error)
+  {
+    m_isWriting = false;
+    m_inFlight.clear();
+    if (error) {
+      if (error == boost::asio::error::operation_aborted) {
+        return;
+      }
+      close();
+      NDN_THROW(Error(error, "error while sending data to socket"));
+    }
+
+    if (!m_pending.empty()) {
+      flush();
+    }
+    else if (m_wantCancel) {
+      m_wantCancel = false;
+      m_socket->cancel();
+    }
+  }
+
+  void
+  asyncReceive()
+  {
+    m_isReadPending = true;
+    m_socket->async_receive(boost::asio::buffer(m_input.data() + m_inputSize, m_input.size() - m_inputSize),
+      [self = this->shared_from_this()] (const boost::system::error_code& error, std::size_t nBytes) {
+        self->onReceived(error, nBytes);
+      });
+  }
+
+  void
+  onReceived(const boost::system::error_code& error, std::size_t nBytes)
+  {
+    m_isReadPending = false;
+    if (error) {
+      if (error == boost::asio::error::operation_aborted) {
+        // paused (or closed); receiving may have been resumed before this handler ran
+        if (m_isReceiving) {
+          asyncReceive();
+        }
+        return;
+      }
+      close();
+      NDN_THROW(Error(error, "error while receiving data from socket"));
+    }
+
+    m_inputSize += nBytes;
+    std::size_t offset = 0;
+    while (offset < m_inputSize) {
+      auto [isOk, element] = ndn::Block::fromBuffer({m_input.data() + offset, m_inputSize - offset});
+      if (!isOk) {
+        break;
+      }
+      offset += element.size();
+      m_receiveCallback(element);
+      if (!m_isConnected) {
+        return; // closed by the callback
+      }
+    }
+
+    if (offset == 0 && m_inputSize == m_input.size()) {
+      close();
+      NDN_THROW(Error("input buffer full, but a valid TLV cannot be decoded"));
+    }
+    if (offset > 0) {
+      std::memmove(m_input.data(), m_input.data() + offset, m_inputSize - offset);
+      m_inputSize -= offset;
+    }
+
+    if (m_isReceiving) {
+      asyncReceive();
+    }
+  }
+
+private:
+  const typename Protocol::endpoint m_endpoint;
+  const BatchingOptions m_options;
+  std::unique_ptr<typename Protocol::socket> m_socket;
+  std::unique_ptr<boost::asio::steady_timer> m_flushTimer;
+
+  bool m_isConnecting = false;
+  bool m_isReadPending = false;
+  bool m_isWriting = false;
+  bool m_isFlushScheduled = false;
+  bool m_wantCancel = false;
+
+  std::vector<ndn::Block> m_pending;
+  std::size_t m_pendingBytes = 0;
+  std::vector<ndn::Block> m_inFlight; // kept alive until the write completes
+  std::vector<boost::asio::const_buffer> m_buffers;
+
+  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_input;
+  std::size_t m_inputSize = 0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_BATCHING_TRANSPORT_HPP
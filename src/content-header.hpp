@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_CONTENT_HEADER_HPP
+#define NDNTG_CONTENT_HEADER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace ndntg {
+
+/**
+ * @brief Fixed-size header that the server may place at the start of the Data content.
+ *
+ * Layout, in network byte order:
+ *
+ *     magic (4) | version (4) | generation time (8) | valid until (8)
+ *
+ * Times are in microseconds since the Unix epoch, so comparing them with the client clock
+ * assumes that both hosts are synchronized.
+ */
+struct ContentHeader
+{
+  static constexpr uint32_t MAGIC = 0x4e544748; // "NTGH"
+  static constexpr std::size_t SIZE = 24;
+
+  /// content version of the item
+  uint32_t version = 0;
+  /// when the server produced the Data
+  uint64_t generationTime = 0;
+  /// when the next version of the item replaces this one, or zero if the item never changes
+  uint64_t validUntil = 0;
+
+  /**
+   * @brief Writes the header to the SIZE bytes at @p output.
+   */
+  void
+  encode(uint8_t* output) const
+  {
+    writeNumber(output, MAGIC, 4);
+    writeNumber(output + 4, version, 4);
+    writeNumber(output + 8, generationTime, 8);
+    writeNumber(output + 16, validUntil, 8);
+  }
+
+  /**
+   * @brief Reads the header at the start of @p content, if there is one.
+   */
+  static std::optional<ContentHeader>
+  decode(const uint8_t* content, std::size_t size)
+  {
+    if (size < SIZE || readNumber(content, 4) != MAGIC) {
+      return std::nullopt;
+    }
+    ContentHeader header;
+    header.version = static_cast<uint32_t>(readNumber(content + 4, 4));
+    header.generationTime = readNumber(content + 8, 8);
+    header.validUntil = readNumber(content + 16, 8);
+    return header;
+  }
+
+private:
+  static void
+  writeNumber(uint8_t* output, uint64_t value, int nBytes)
+  {
+    for (int i = nBytes - 1; i >= 0; i--) {
+      output[i] = static_cast<uint8_t>(value);
+      value >>= 8;
+    }
+  }
+
+  static uint64_t
+  readNumber(const uint8_t* input, int nBytes)
+  {
+    uint64_t value = 0;
+    for (int i = 0; i < nBytes; i++) {
+      value = (value << 8) | input[i];
+    }
+    return value;
+  }
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_CONTENT_HEADER_HPP
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_CONTENT_VERSIONS_HPP
+#define NDNTG_CONTENT_VERSIONS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include <boost/core/noncopyable.hpp>
+
+namespace ndntg {
+
+/**
+ * @brief Content versions of the items of one traffic pattern, which change over time.
+ *
+ * Items are identified by a hash of their name. Versions are only computed when an item is
+ * requested, so no timer runs per item:
+ *  - scheduled updates change every item once per interval, with a phase derived from its hash
+ *    so that updates are spread evenly over the interval; no state is kept
+ *  - Poisson updates change every item at a given rate; each hash slot keeps its version and the
+ *    time of its next update packed in one 64-bit word, i.e. 8 bytes per item. Because Poisson
+ *    arrivals are memoryless, the updates missed since the last request are drawn all at once.
+ *
+ * Lookups are lock-free, so one instance can be shared by several threads.
+ */
+class ContentVersions : boost::noncopyable
+{
+public:
+  struct Version
+  {
+    uint32_t number;
+    /// time until the next version replaces this one
+    std::chrono::milliseconds remaining;
+  };
+
+  static std::unique_ptr<ContentVersions>
+  makeScheduled(std::chrono::milliseconds interval)
+  {
+    auto versions = std::unique_ptr<ContentVersions>(new ContentVersions);
+    versions->m_interval = std::max<uint64_t>(interval.count(), 1);
+    return versions;
+  }
+
+  /**
+   * @param rate updates per second of each item
+   * @param nSlots number of hash slots; items that share a slot share their version
+   */
+  static std::unique_ptr<ContentVersions>
+  makePoisson(double rate, std::size_t nSlots)
+  {
+    auto versions = std::unique_ptr<ContentVersions>(new ContentVersions);
+    versions->m_rate = rate / 1000.0;
+    versions->m_nSlots = std::max<std::size_t>(nSlots, 1);
+    // value-initialization zeroes the slots, which marks them as not requested yet
+    versions->m_slots.reset(new std::atomic<uint64_t>[versions->m_nSlots]());
+    return versions;
+  }
+
+  template<typename Engine>
+  Version
+  get(uint64_t itemHash, Engine& engine)
+  {
+    // 32-bit millisecond times wrap after about 49 days
+    auto now = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - m_start).count());
+    if (m_slots == nullptr) {
+      uint64_t phase = itemHash % m_interval;
+      uint64_t number = (now + phase) / m_interval;
+      uint64_t next = (number + 1) * m_interval - phase;
+      return {static_cast<uint32_t>(number), std::chrono::milliseconds(next - now)};
+    }
+
+    auto& slot = m_slots[itemHash % m_nSlots];
+    uint64_t state = slot.load(std::memory_order_relaxed);
+    while (true) {
+      auto number = static_cast<uint32_t>(state >> 32);
+      auto next = static_cast<uint32_t>(state);
+      if (next != 0 && now < next) {
+        return {number, std::chrono::milliseconds(next - now)};
+      }
+
+      // an update happened at 'next' (none if the slot is new, counting from the start),
+      // plus a Poisson number of updates since then
+      double mean = m_rate * (now - next);
+      if (mean > 0.0) {
+        number += std::poisson_distribution<uint32_t>(mean)(engine);
+      }
+      if (next != 0) {
+        number++;
+      }
+      double gap = std::clamp(std::round(std::exponential_distribution<double>(m_rate)(engine)), 1.0, 1e9);
+      auto newNext = now + static_cast<uint32_t>(gap);
+      uint64_t newState = (uint64_t(number) << 32) | newNext;
+      if (slot.compare_exchange_weak(state, newState, std::memory_order_relaxed)) {
+        return {number, std::chrono::milliseconds(newNext - now)};
+      }
+    }
+  }
+
+private:
+  ContentVersions() = default;
+
+private:
+  const std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+  uint64_t m_interval = 0; // milliseconds, scheduled updates only
+  double m_rate = 0.0;     // updates per millisecond, Poisson updates only
+  std::size_t m_nSlots = 0;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_CONTENT_VERSIONS_HPP
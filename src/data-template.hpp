@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_DATA_TEMPLATE_HPP
+#define NDNTG_DATA_TEMPLATE_HPP
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+#include <ndn-cxx/util/exception.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace ndntg {
+
+/**
+ * @brief Pre-encoded Data packet of one traffic pattern, completed with a name and a signature value.
+ *
+ * The MetaInfo, Content and SignatureInfo elements never change for a pattern, so they are encoded
+ * once. A response is then signed over the pieces {Name, template} without copying them, and
+ * assembled in a single exactly-sized buffer:
+ *
+ *     Data = T L | Name (from the Interest) | MetaInfo Content SignatureInfo | SignatureValue
+ *
+ * For patterns whose content varies, the Content element is instead made of its type and length,
+ * encoded for each response, followed by pieces supplied by the caller: a per-response header and
+ * a payload, e.g. a slice of a shared buffer. The pieces are only copied once, into the assembled
+ * packet.
+ */
+class DataTemplate
+{
+public:
+  /**
+   * @param prototype Data with the MetaInfo, Content and SignatureInfo of every response;
+   *                  its name is ignored
+   */
+  explicit
+  DataTemplate(const ndn::Data& prototype)
+  {
+    ndn::EncodingBuffer encoder;
+    prototype.wireEncode(encoder, true);
+    // the unsigned portion starts with the Name TLV, which is replaced in every response
+    std::size_t offset = prototype.getName().wireEncode().size();
+    while (offset < encoder.size()) {
+      auto [isOk, element] = ndn::Block::fromBuffer({encoder.data() + offset, encoder.size() - offset});
+      if (!isOk) {
+        NDN_THROW(std::invalid_argument("Cannot decode the prototype Data"));
+      }
+      auto& field = element.type() == ndn::tlv::MetaInfo ? m_metaInfo :
+                    element.type() == ndn::tlv::Content ? m_content : m_signatureInfo;
+      field.insert(field.end(), element.begin(), element.end());
+      if (element.type() == ndn::tlv::Content) {
+        m_contentValueOffset = element.size() - element.value_size();
+      }
+      offset += element.size();
+    }
+  }
+
+  /**
+   * @brief Returns the content of the prototype.
+   */
+  ndn::span<const uint8_t>
+  getContentValue() const
+  {
+    return ndn::span<const uint8_t>(m_content).subspan(m_contentValueOffset);
+  }
+
+  /**
+   * @brief Returns the portion of the response covered by the signature.
+   *
+   * The pieces reference @p name and the template; both must outlive the returned value.
+   */
+  ndn::InputBuffers
+  getSignedPortion(const ndn::Name& name) const
+  {
+    const auto& nameWire = name.wireEncode();
+    return {ndn::span<const uint8_t>(nameWire.data(), nameWire.size()), m_metaInfo, m_content, m_signatureInfo};
+  }
+
+  /**
+   * @brief Returns the portion of the response covered by the signature, with @p header followed
+   *        by @p payload as content.
+   *
+   * The pieces reference the arguments and the template; they are valid until the next call.
+   */
+  ndn::InputBuffers
+  getSignedPortion(const ndn::Name& name, ndn::span<const uint8_t> header, ndn::span<const uint8_t> payload)
+  {
+    const auto& nameWire = name.wireEncode();
+    return {ndn::span<const uint8_t>(nameWire.data(), nameWire.size()), m_metaInfo,
+            encodeContentType(header.size() + payload.size()), header, payload, m_signatureInfo};
+  }
+
+  /**
+   * @brief Returns the complete response named @p name, with signature value @p signature.
+   */
+  ndn::Data
+  makeData(const ndn::Name& name, ndn::span<const uint8_t> signature) const
+  {
+    return assemble(name, m_content, {}, {}, signature);
+  }
+
+  /**
+   * @brief Returns the complete response named @p name, with @p header followed by @p payload
+   *        as content, and signature value @p signature.
+   */
+  ndn::Data
+  makeData(const ndn::Name& name, ndn::span<const uint8_t> header, ndn::span<const uint8_t> payload,
+           ndn::span<const uint8_t> signature)
+  {
+    return assemble(name, encodeContentType(header.size() + payload.size()), header, payload, signature);
+  }
+
+private:
+  ndn::span<const uint8_t>
+  encodeContentType(std::size_t length)
+  {
+    std::size_t size = 0;
+    m_contentType[size++] = ndn::tlv::Content;
+    if (length < 253) {
+      m_contentType[size++] = static_cast<uint8_t>(length);
+    }
+    else {
+      int nBytes = length <= 0xFFFF ? 2 : 4;
+      m_contentType[size++] = nBytes == 2 ? 253 : 254;
+      for (int shift = (nBytes - 1) * 8; shift >= 0; shift -= 8) {
+        m_contentType[size++] = static_cast<uint8_t>(length >> shift);
+      }
+    }
+    return {m_contentType.data(), size};
+  }
+
+  ndn::Data
+  assemble(const ndn::Name& name, ndn::span<const uint8_t> content, ndn::span<const uint8_t> header,
+           ndn::span<const uint8_t> payload, ndn::span<const uint8_t> signature) const
+  {
+    const auto& nameWire = name.wireEncode();
+    std::size_t valueSize = nameWire.size() + m_metaInfo.size() + content.size() + header.size() + payload.size() +
+                            m_signatureInfo.size() + ndn::tlv::sizeOfVarNumber(ndn::tlv::SignatureValue) +
+                            ndn::tlv::sizeOfVarNumber(signature.size()) + signature.size();
+    std::size_t totalSize = ndn::tlv::sizeOfVarNumber(ndn::tlv::Data) + ndn::tlv::sizeOfVarNumber(valueSize) +
+                            valueSize;
+
+    // elements are prepended, so the buffer is filled back to front without reallocation
+    ndn::EncodingBuffer encoder(totalSize, 0);
+    encoder.prependBytes(signature);
+    encoder.prependVarNumber(signature.size());
+    encoder.prependVarNumber(ndn::tlv::SignatureValue);
+    encoder.prependBytes(m_signatureInfo);
+    encoder.prependBytes(payload);
+    encoder.prependBytes(header);
+    encoder.prependBytes(content);
+    encoder.prependBytes(m_metaInfo);
+    encoder.prependBytes({nameWire.data(), nameWire.size()});
+    encoder.prependVarNumber(valueSize);
+    encoder.prependVarNumber(ndn::tlv::Data);
+
+    // Face::put() only accepts ndn::Data, so the packet is decoded once; its wire encoding is kept
+    return ndn::Data(encoder.block());
+  }
+
+private:
+  std::vector<uint8_t> m_metaInfo;      // MetaInfo TLV, if any
+  std::vector<uint8_t> m_content;       // Content TLV of the prototype
+  std::vector<uint8_t> m_signatureInfo; // SignatureInfo TLV
+  std::size_t m_contentValueOffset = 0;
+  std::array<uint8_t, 6> m_contentType; // Content type and length of a variable response
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_DATA_TEMPLATE_HPP
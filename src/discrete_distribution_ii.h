@@ -49,6 +49,7 @@
 #include <functional>
 #include <map>
 #include <cmath>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <vector>
@@ -71,10 +72,30 @@ class discrete_distribution_30bit {
 
     int size;
 
+    /*
+     * The sampling tables. They point either into P, V and K above or into
+     * external storage (e.g. a memory-mapped cache file) kept alive by _storage.
+     */
+    const double* _P;
+    const double* _V;
+    const int*    _K;
+    std::shared_ptr<const void> _storage;
+
  public:
 
     typedef _IntType result_type;
 
+    /*
+     * A read-only view of the tables, used to persist and restore them.
+     */
+    struct tables_type {
+        const int*    J;     // 256 entries
+        const double* V;     // size entries
+        const int*    K;     // size entries
+        const double* P;     // size entries
+        int           size;
+    };
+
     /* 
      * The constructor takes as input iterators over probabilities. The 
      * probabilities should sum to one.
@@ -107,8 +128,35 @@ class discrete_distribution_30bit {
         for ( int n = 0; n < size; ++n ) P[n] /= norm;
 
         init();
+
+        _P = P.data();
+        _V = V.data();
+        _K = K.data();
+    }
+
+    /*
+     * Restores a distribution from tables previously obtained with tables().
+     * The tables are not copied; storage must keep them alive.
+     */
+    discrete_distribution_30bit( const tables_type& t,
+                                 std::shared_ptr<const void> storage ):
+                                                   size( t.size ),
+                                                   _P( t.P ),
+                                                   _V( t.V ),
+                                                   _K( t.K ),
+                                                   _storage( std::move( storage ) ) {
+
+        if ( size <= 0 ) {
+            perror( "no probablities." );
+            abort();
+        }
+
+        std::copy( t.J, t.J + 256, _J );
     }
 
+    discrete_distribution_30bit( const discrete_distribution_30bit& ) = delete;
+    discrete_distribution_30bit& operator=( const discrete_distribution_30bit& ) = delete;
+
     ~discrete_distribution_30bit(){}
 
     /* 
@@ -127,10 +175,10 @@ class discrete_distribution_30bit {
         } else {
             double U = static_cast<double>(uran)*2.328306437e-10;
             d = static_cast<int>( static_cast<double>( size )*U );
-            if ( U < V[d] ) {
+            if ( U < _V[d] ) {
                 return d;
             } else {
-                return K[d];
+                return _K[d];
             }
         }
 
@@ -145,7 +193,15 @@ class discrete_distribution_30bit {
      *
      */
     std::vector<double> probabilities() const {
-        return std::vector<double>( P.begin(), P.end() );
+        return std::vector<double>( _P, _P + size );
+    }
+
+    /* 
+     * Returns a view of the sampling tables.
+     *
+     */
+    tables_type tables() const {
+        return tables_type{ _J, _V, _K, _P, size };
     }
 
     /* 
@@ -170,7 +226,7 @@ class discrete_distribution_30bit {
      */
     friend bool operator==( const discrete_distribution_30bit& v1, 
                             const discrete_distribution_30bit& v2) {
-        return v1.P == v2.P;
+        return v1.size == v2.size && std::equal( v1._P, v1._P + v1.size, v2._P );
     }
 
 
@@ -258,7 +314,7 @@ private:
 template<typename _IntType>
 inline bool operator!=( const rng::discrete_distribution_30bit<_IntType>& v1, 
                         const rng::discrete_distribution_30bit<_IntType>& v2) {
-        return !(v1.P == v2.P);
+        return !(v1 == v2);
 }
 
 };  // namespace rng
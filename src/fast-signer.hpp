@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_FAST_SIGNER_HPP
+#define NDNTG_FAST_SIGNER_HPP
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/security/certificate.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-info.hpp>
+#include <ndn-cxx/security/tpm/tpm.hpp>
+#include <ndn-cxx/security/transform/base64-decode.hpp>
+#include <ndn-cxx/security/transform/buffer-source.hpp>
+#include <ndn-cxx/security/transform/stream-sink.hpp>
+#include <ndn-cxx/util/exception.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <array>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <boost/assert.hpp>
+
+#include <openssl/evp.h>
+
+namespace ndntg {
+
+/**
+ * @brief Signs the packets of one traffic pattern without going through KeyChain::sign() every time.
+ *
+ * The SignatureInfo is computed once, by signing a dummy packet with the KeyChain, and is reused
+ * with its cached encoding. Each packet is then encoded once and its signature computed directly:
+ *  - DigestSha256: SHA-256 with a reused OpenSSL digest context
+ *  - HMAC-SHA256: SHA-256 midstates after the (key XOR ipad) and (key XOR opad) blocks are
+ *    precomputed, so only the signed portion and the inner hash are hashed per packet
+ *  - ECDSA and RSA: the TPM is called directly with the precomputed key name, which skips the
+ *    PIB lookups done by KeyChain::sign()
+ *
+ * The signed portion starts with the Name, which differs for every packet, so there is no constant
+ * prefix of the packet itself whose hash state could be reused.
+ *
+ * Any other signer falls back to KeyChain::sign(). A FastSigner must only be used by one thread.
+ */
+class FastSigner
+{
+public:
+  /**
+   * @param keyChain KeyChain that holds the signing key; must outlive the signer
+   * @param signingInfo signing parameters in the SigningInfo string format, e.g. "id:/A" or
+   *                    "hmac-sha256:<base64 key>"; empty means the default identity
+   */
+  FastSigner(ndn::KeyChain& keyChain, const std::string& signingInfo)
+    : m_keyChain(&keyChain)
+    , m_signingInfo(signingInfo)
+  {
+    ndn::Data dummy("/ndntg/fast-signer");
+    m_keyChain->sign(dummy, m_signingInfo);
+    m_signatureInfo = dummy.getSignatureInfo();
+    m_signatureInfo.wireEncode(); // cache the encoding, which is kept by every copy
+
+    switch (m_signatureInfo.getSignatureType()) {
+      case ndn::tlv::DigestSha256:
+        m_ctx.reset(EVP_MD_CTX_new());
+        m_type = Type::DIGEST_SHA256;
+        break;
+      case ndn::tlv::SignatureHmacWithSha256: {
+        constexpr std::string_view scheme = "hmac-sha256:";
+        if (signingInfo.compare(0, scheme.size(), scheme) == 0) {
+          initHmac(decodeBase64(signingInfo.substr(scheme.size())));
+          m_type = Type::HMAC_SHA256;
+        }
+        break;
+      }
+      case ndn::tlv::SignatureSha256WithRsa:
+      case ndn::tlv::SignatureSha256WithEcdsa: {
+        if (!m_signatureInfo.hasKeyLocator()) {
+          break;
+        }
+        const auto& locatorName = m_signatureInfo.getKeyLocator().getName();
+        m_keyName = ndn::security::Certificate::isValidName(locatorName) ?
+                    ndn::security::extractKeyNameFromCertName(locatorName) : locatorName;
+        if (m_keyChain->getTpm().hasKey(m_keyName)) {
+          m_type = Type::TPM;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  /**
+   * @brief Returns true if packets are signed without KeyChain::sign().
+   */
+  bool
+  isFastPath() const
+  {
+    return m_type != Type::KEY_CHAIN;
+  }
+
+  const ndn::SignatureInfo&
+  getSignatureInfo() const
+  {
+    return m_signatureInfo;
+  }
+
+  void
+  sign(ndn::Data& data)
+  {
+    if (m_type == Type::KEY_CHAIN) {
+      m_keyChain->sign(data, m_signingInfo);
+      return;
+    }
+
+    data.setSignatureInfo(m_signatureInfo);
+    ndn::EncodingBuffer encoder;
+    data.wireEncode(encoder, true);
+    data.wireEncode(encoder, computeSignature({ndn::span<const uint8_t>(encoder.data(), encoder.size())}));
+  }
+
+  /**
+   * @brief Signs @p interest in the v0.3 signed Interest format.
+   *
+   * Like ndn::security::InterestSigner, every Interest gets a SignatureTime and a random
+   * SignatureNonce, so that a validator with replay protection accepts it.
+   */
+  void
+  sign(ndn::Interest& interest)
+  {
+    auto info = m_signatureInfo;
+    info.setTime();
+    std::array<uint8_t, 8> nonce;
+    ndn::random::generateSecureBytes(nonce);
+    info.setNonce(nonce);
+
+    if (m_type == Type::KEY_CHAIN) {
+      auto params = m_signingInfo;
+      params.setSignedInterestFormat(ndn::security::SignedInterestFormat::V03);
+      params.setSignatureInfo(info);
+      m_keyChain->sign(interest, params);
+      return;
+    }
+
+    // this also adds an empty ApplicationParameters element if there is none
+    interest.setSignatureInfo(info);
+    interest.setSignatureValue(computeSignature(interest.extractSignedRanges()));
+  }
+
+  /**
+   * @brief Computes the signature value over @p signedPortion, which must end with getSignatureInfo().
+   * @pre isFastPath()
+   * @return the signature value, valid until the next call
+   */
+  ndn::span<const uint8_t>
+  computeSignature(const ndn::InputBuffers& signedPortion)
+  {
+    BOOST_ASSERT(isFastPath());
+
+    if (m_type == Type::TPM) {
+      m_tpmSignature = m_keyChain->getTpm().sign(signedPortion, m_keyName, ndn::DigestAlgorithm::SHA256);
+      if (m_tpmSignature == nullptr) {
+        NDN_THROW(ndn::security::KeyChain::Error("Failed to sign with key " + m_keyName.toUri()));
+      }
+      return *m_tpmSignature;
+    }
+
+    unsigned int digestSize = 0;
+    if (m_type == Type::DIGEST_SHA256) {
+      EVP_DigestInit_ex(m_ctx.get(), EVP_sha256(), nullptr);
+      for (const auto& piece : signedPortion) {
+        EVP_DigestUpdate(m_ctx.get(), piece.data(), piece.size());
+      }
+      EVP_DigestFinal_ex(m_ctx.get(), m_digest.data(), &digestSize);
+    }
+    else {
+      // HMAC(K, m) = H((K ^ opad) || H((K ^ ipad) || m)), starting from the precomputed midstates
+      EVP_MD_CTX_copy_ex(m_ctx.get(), m_innerCtx.get());
+      for (const auto& piece : signedPortion) {
+        EVP_DigestUpdate(m_ctx.get(), piece.data(), piece.size());
+      }
+      EVP_DigestFinal_ex(m_ctx.get(), m_digest.data(), &digestSize);
+      EVP_MD_CTX_copy_ex(m_ctx.get(), m_outerCtx.get());
+      EVP_DigestUpdate(m_ctx.get(), m_digest.data(), digestSize);
+      EVP_DigestFinal_ex(m_ctx.get(), m_digest.data(), &digestSize);
+    }
+    return ndn::span<const uint8_t>(m_digest.data(), digestSize);
+  }
+
+private:
+  static std::string
+  decodeBase64(const std::string& input)
+  {
+    namespace tr = ndn::security::transform;
+    std::ostringstream os;
+    tr::bufferSource(input) >> tr::base64Decode(false) >> tr::streamSink(os);
+    return os.str();
+  }
+
+  void
+  initHmac(std::string key)
+  {
+    constexpr std::size_t BLOCK_SIZE = 64; // SHA-256 block size
+
+    m_ctx.reset(EVP_MD_CTX_new());
+    if (key.size() > BLOCK_SIZE) {
+      std::array<uint8_t, EVP_MAX_MD_SIZE> hashedKey;
+      unsigned int hashedKeySize = 0;
+      EVP_Digest(key.data(), key.size(), hashedKey.data(), &hashedKeySize, EVP_sha256(), nullptr);
+      key.assign(reinterpret_cast<const char*>(hashedKey.data()), hashedKeySize);
+    }
+    key.resize(BLOCK_SIZE, '\0');
+
+    auto makeMidstate = [&key] (uint8_t pad) {
+      std::array<uint8_t, BLOCK_SIZE> block;
+      for (std::size_t i = 0; i < BLOCK_SIZE; i++) {
+        block[i] = static_cast<uint8_t>(key[i]) ^ pad;
+      }
+      EvpMdCtxPtr ctx(EVP_MD_CTX_new());
+      EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr);
+      EVP_DigestUpdate(ctx.get(), block.data(), block.size());
+      return ctx;
+    };
+    m_innerCtx = makeMidstate(0x36);
+    m_outerCtx = makeMidstate(0x5c);
+  }
+
+private:
+  enum class Type {
+    KEY_CHAIN,
+    DIGEST_SHA256,
+    HMAC_SHA256,
+    TPM,
+  };
+
+  struct EvpMdCtxDeleter
+  {
+    void
+    operator()(EVP_MD_CTX* ctx) const
+    {
+      EVP_MD_CTX_free(ctx);
+    }
+  };
+  using EvpMdCtxPtr = std::unique_ptr<EVP_MD_CTX, EvpMdCtxDeleter>;
+
+  ndn::KeyChain* m_keyChain;
+  ndn::security::SigningInfo m_signingInfo;
+  ndn::SignatureInfo m_signatureInfo;
+  Type m_type = Type::KEY_CHAIN;
+  ndn::Name m_keyName;
+  EvpMdCtxPtr m_ctx;
+  EvpMdCtxPtr m_innerCtx;
+  EvpMdCtxPtr m_outerCtx;
+  std::array<uint8_t, EVP_MAX_MD_SIZE> m_digest;
+  ndn::ConstBufferPtr m_tpmSignature;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_FAST_SIGNER_HPP
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_HISTOGRAM_HPP
+#define NDNTG_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ndntg {
+
+/**
+ * @brief Fixed-size log-linear histogram of non-negative values.
+ *
+ * Every power-of-two range is split into SUB_BUCKETS linear buckets, which bounds the relative
+ * error of percentile estimates to about 1/SUB_BUCKETS. Recording a value is O(1) and does not
+ * allocate, and two histograms can be merged, so it is suitable for per-packet hot paths.
+ */
+class Histogram
+{
+public:
+  static constexpr int SUB_BUCKETS = 16;
+  static constexpr int MIN_EXPONENT = -20; // about 1e-6
+  static constexpr int MAX_EXPONENT = 44;  // about 1.7e13
+  static constexpr int N_BUCKETS = (MAX_EXPONENT - MIN_EXPONENT) * SUB_BUCKETS + 1;
+
+  void
+  record(double value)
+  {
+    if (!(value >= 0.0)) {
+      value = 0.0;
+    }
+    m_buckets[getBucketIndex(value)]++;
+    m_count++;
+    m_sum += value;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+  }
+
+  void
+  merge(const Histogram& other)
+  {
+    for (int i = 0; i < N_BUCKETS; i++) {
+      m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+  }
+
+  void
+  reset()
+  {
+    *this = Histogram();
+  }
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  double
+  getSum() const
+  {
+    return m_sum;
+  }
+
+  double
+  getMean() const
+  {
+    return m_count > 0 ? m_sum / m_count : 0.0;
+  }
+
+  double
+  getMin() const
+  {
+    return m_count > 0 ? m_min : 0.0;
+  }
+
+  double
+  getMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @brief Returns an estimate of the p-th percentile, with p in [0, 100].
+   *
+   * The estimate is the midpoint of the bucket containing the requested rank,
+   * clamped to the observed minimum and maximum.
+   */
+  double
+  getPercentile(double p) const
+  {
+    if (m_count == 0) {
+      return 0.0;
+    }
+
+    auto rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * m_count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (int i = 0; i < N_BUCKETS; i++) {
+      seen += m_buckets[i];
+      if (seen >= rank) {
+        double mid = (getBucketLowerBound(i) + getBucketLowerBound(i + 1)) / 2.0;
+        return std::clamp(mid, m_min, m_max);
+      }
+    }
+    return m_max;
+  }
+
+private:
+  static int
+  getBucketIndex(double value)
+  {
+    if (value < std::ldexp(1.0, MIN_EXPONENT)) {
+      return 0;
+    }
+
+    int exponent = 0;
+    double mantissa = std::frexp(value, &exponent); // value = mantissa * 2^exponent, mantissa in [0.5, 1)
+    exponent--;
+    if (exponent >= MAX_EXPONENT) {
+      return N_BUCKETS - 1;
+    }
+    auto sub = static_cast<int>((mantissa * 2.0 - 1.0) * SUB_BUCKETS);
+    return 1 + (exponent - MIN_EXPONENT) * SUB_BUCKETS + std::min(sub, SUB_BUCKETS - 1);
+  }
+
+  static double
+  getBucketLowerBound(int index)
+  {
+    if (index <= 0) {
+      return 0.0;
+    }
+    if (index >= N_BUCKETS) {
+      return std::ldexp(1.0, MAX_EXPONENT);
+    }
+    index--;
+    int exponent = MIN_EXPONENT + index / SUB_BUCKETS;
+    int sub = index % SUB_BUCKETS;
+    return std::ldexp(1.0 + static_cast<double>(sub) / SUB_BUCKETS, exponent);
+  }
+
+private:
+  std::array<uint64_t, N_BUCKETS> m_buckets{};
+  uint64_t m_count = 0;
+  double m_sum = 0.0;
+  double m_min = std::numeric_limits<double>::max();
+  double m_max = 0.0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_HISTOGRAM_HPP
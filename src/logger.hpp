@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -46,6 +47,9 @@ public:
   void
   log(std::string_view logLine, bool printTimestamp, bool printToConsole)
   {
+    // the server logs from several worker threads
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     boost::container::static_vector<std::reference_wrapper<std::ostream>, 2> destinations;
     if (!m_logLocation.empty()) {
       destinations.emplace_back(m_logFile);
@@ -130,6 +134,7 @@ private:
   std::string m_logLocation;
   std::ofstream m_logFile;
   bool m_wantUnixTime = true;
+  std::mutex m_mutex;
 };
 
 } // namespace ndntg
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_MAPPED_FILE_CACHE_HPP
+#define NDNTG_MAPPED_FILE_CACHE_HPP
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include <boost/core/noncopyable.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndntg {
+
+/**
+ * @brief Read-only memory mapping of a whole regular file.
+ */
+class MappedFile : boost::noncopyable
+{
+public:
+  /**
+   * @return the mapping, or nullptr if @p path is not a readable regular file
+   */
+  static std::shared_ptr<const MappedFile>
+  open(const std::string& path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    std::shared_ptr<MappedFile> file;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+      if (st.st_size == 0) {
+        file.reset(new MappedFile(nullptr, 0));
+      }
+      else {
+        // pages are only read from disk when a segment first touches them
+        void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED) {
+          file.reset(new MappedFile(static_cast<const uint8_t*>(addr), st.st_size));
+        }
+      }
+    }
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return file;
+  }
+
+  ~MappedFile()
+  {
+    if (m_data != nullptr) {
+      ::munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+  }
+
+  const uint8_t*
+  data() const
+  {
+    return m_data;
+  }
+
+  std::size_t
+  size() const
+  {
+    return m_size;
+  }
+
+private:
+  MappedFile(const uint8_t* data, std::size_t size)
+    : m_data(data)
+    , m_size(size)
+  {
+  }
+
+private:
+  const uint8_t* m_data;
+  std::size_t m_size;
+};
+
+/**
+ * @brief Bounded cache of the mapped files under one directory, shared by several threads.
+ *
+ * Files are mapped on their first request. When the number of mapped files or their total size
+ * exceeds the limits, the least recently used files are unmapped. A file that is still referenced,
+ * e.g. by a response being built, stays mapped until it is released.
+ */
+class MappedFileCache : boost::noncopyable
+{
+public:
+  struct Counters
+  {
+    uint64_t nHits = 0;
+    uint64_t nMisses = 0;
+    uint64_t nFailures = 0;
+    uint64_t nEvictions = 0;
+  };
+
+  MappedFileCache(std::string directory, std::size_t maxFiles, std::size_t maxBytes)
+    : m_directory(std::move(directory))
+    , m_maxFiles(maxFiles)
+    , m_maxBytes(maxBytes)
+  {
+  }
+
+  /**
+   * @param relativePath path below the directory, which the caller has checked not to escape it
+   * @return the mapping, or nullptr if the file cannot be opened
+   */
+  std::shared_ptr<const MappedFile>
+  get(const std::string& relativePath)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (auto it = m_entries.find(relativePath); it != m_entries.end()) {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.position);
+      m_counters.nHits++;
+      return it->second.file;
+    }
+
+    // opening and mapping may block on the file system, so other threads are not held up
+    lock.unlock();
+    auto file = MappedFile::open(m_directory + "/" + relativePath);
+    lock.lock();
+
+    if (file == nullptr) {
+      m_counters.nFailures++;
+      return nullptr;
+    }
+    m_counters.nMisses++;
+    if (auto it = m_entries.find(relativePath); it != m_entries.end()) {
+      // mapped by another thread in the meantime
+      m_lru.splice(m_lru.begin(), m_lru, it->second.position);
+      return it->second.file;
+    }
+
+    m_lru.push_front(relativePath);
+    m_entries.emplace(relativePath, Entry{file, m_lru.begin()});
+    m_nBytes += file->size();
+    while (m_lru.size() > 1 && (m_lru.size() > m_maxFiles || m_nBytes > m_maxBytes)) {
+      auto victim = m_entries.find(m_lru.back());
+      m_nBytes -= victim->second.file->size();
+      m_entries.erase(victim);
+      m_lru.pop_back();
+      m_counters.nEvictions++;
+    }
+    return file;
+  }
+
+  Counters
+  getCounters() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_counters;
+  }
+
+  /**
+   * @brief Returns true if @p component can be used as a path component below the directory.
+   */
+  static bool
+  isSafePathComponent(std::string_view component)
+  {
+    return !component.empty() && component != "." && component != ".." &&
+           component.find('/') == std::string_view::npos && component.find('\0') == std::string_view::npos;
+  }
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<const MappedFile> file;
+    std::list<std::string>::iterator position;
+  };
+
+  const std::string m_directory;
+  const std::size_t m_maxFiles;
+  const std::size_t m_maxBytes;
+
+  mutable std::mutex m_mutex;
+  std::list<std::string> m_lru; // most recently used first
+  std::unordered_map<std::string, Entry> m_entries;
+  std::size_t m_nBytes = 0;
+  Counters m_counters;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_MAPPED_FILE_CACHE_HPP
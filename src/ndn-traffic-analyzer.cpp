@@ -0,0 +1,574 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "histogram.hpp"
+#include "sketch.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+namespace ndntg {
+
+/**
+ * @brief Characterizes a request workload and derives a client scenario from it.
+ *
+ * Input is either the log of ndn-traffic-client ("Sending Interest" lines) or of
+ * ndn-traffic-server ("Interest Received" lines), or a plain trace with one name per
+ * line, optionally preceded by a Unix timestamp in seconds.
+ */
+class NdnTrafficAnalyzer : boost::noncopyable
+{
+public:
+  struct ZipfFit
+  {
+    double s = 0.0;
+    double q = 0.0;
+    double logLikelihood = 0.0;
+    std::size_t nRanks = 0;
+  };
+
+  void
+  setSketchMode(std::size_t width, std::size_t depth)
+  {
+    m_sketch.emplace(width, depth);
+  }
+
+  void
+  setTopK(std::size_t k)
+  {
+    m_topK = std::max<std::size_t>(k, 2);
+  }
+
+  void
+  setLocalityTableSize(unsigned log2Size)
+  {
+    m_localityTable.assign(std::size_t(1) << log2Size, LocalityEntry{});
+  }
+
+  bool
+  processStream(std::istream& is)
+  {
+    std::string line;
+    while (std::getline(is, line)) {
+      std::optional<double> timestamp;
+      std::string_view name;
+      if (parseLine(line, timestamp, name)) {
+        processRequest(timestamp, name);
+      }
+      else if (!line.empty() && line[0] != '[') {
+        m_nIgnoredLines++;
+      }
+    }
+    return !is.bad();
+  }
+
+  /**
+   * @brief Returns the item counts sorted in descending order, truncated to the top-K.
+   */
+  std::vector<std::pair<std::string, uint64_t>>
+  getRankedItems() const
+  {
+    const auto& items = m_sketch ? m_topItems : m_exactItems;
+    std::vector<std::pair<std::string, uint64_t>> ranked(items.begin(), items.end());
+    if (m_sketch) {
+      // counts of tracked items are only refreshed while they exceed the top-K minimum
+      for (auto& item : ranked) {
+        item.second = m_sketch->estimate(hashBytes(item.first));
+      }
+    }
+    std::sort(ranked.begin(), ranked.end(), [] (const auto& a, const auto& b) {
+      return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    if (ranked.size() > m_topK) {
+      ranked.resize(m_topK);
+    }
+    return ranked;
+  }
+
+  /**
+   * @brief Fits Zipf-Mandelbrot s and q by maximum likelihood over the ranked counts.
+   *
+   * The likelihood is conditioned on the observed ranks 1..K, so the fit is valid on
+   * a truncated top-K list and does not depend on the (possibly unknown) catalog size.
+   */
+  static std::optional<ZipfFit>
+  fitZipfMandelbrot(const std::vector<uint64_t>& counts)
+  {
+    if (counts.size() < 2) {
+      return std::nullopt;
+    }
+
+    auto logLikelihood = [&counts] (double s, double q) {
+      double weighted = 0.0;
+      double total = 0.0;
+      double partition = 0.0;
+      for (std::size_t k = 0; k < counts.size(); k++) {
+        double logRank = std::log(static_cast<double>(k + 1) + q);
+        weighted += counts[k] * logRank;
+        total += counts[k];
+        partition += std::exp(-s * logRank);
+      }
+      return -s * weighted - total * std::log(partition);
+    };
+
+    // for fixed q the log-likelihood is concave in s
+    auto maximizeS = [&] (double q) {
+      double lo = MIN_S, hi = MAX_S;
+      for (int i = 0; i < 80; i++) {
+        double m1 = lo + (hi - lo) * 0.381966;
+        double m2 = hi - (hi - lo) * 0.381966;
+        if (logLikelihood(m1, q) < logLikelihood(m2, q))
+          lo = m1;
+        else
+          hi = m2;
+      }
+      double s = (lo + hi) / 2.0;
+      return std::make_pair(s, logLikelihood(s, q));
+    };
+
+    // coarse geometric grid over q, then golden-section refinement around the best point
+    std::vector<double> grid{0.0};
+    for (double q = 0.125; q <= MAX_Q; q *= std::sqrt(2.0)) {
+      grid.push_back(q);
+    }
+
+    std::size_t best = 0;
+    ZipfFit fit;
+    fit.logLikelihood = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < grid.size(); i++) {
+      auto [s, ll] = maximizeS(grid[i]);
+      if (ll > fit.logLikelihood) {
+        best = i;
+        fit.s = s;
+        fit.q = grid[i];
+        fit.logLikelihood = ll;
+      }
+    }
+
+    double lo = best > 0 ? grid[best - 1] : 0.0;
+    double hi = best + 1 < grid.size() ? grid[best + 1] : grid[best];
+    for (int i = 0; i < 40 && hi - lo > 1e-3; i++) {
+      double m1 = lo + (hi - lo) * 0.381966;
+      double m2 = hi - (hi - lo) * 0.381966;
+      if (maximizeS(m1).second < maximizeS(m2).second)
+        lo = m1;
+      else
+        hi = m2;
+    }
+    double q = (lo + hi) / 2.0;
+    auto [s, ll] = maximizeS(q);
+    if (ll > fit.logLikelihood) {
+      fit.s = s;
+      fit.q = q;
+      fit.logLikelihood = ll;
+    }
+
+    fit.nRanks = counts.size();
+    return fit;
+  }
+
+  void
+  printReport(std::ostream& os, const std::optional<ZipfFit>& fit) const
+  {
+    os << "\n== Workload Report ==\n\n";
+    os << "Total Requests              = " << m_nRequests << "\n";
+    os << "Ignored Lines               = " << m_nIgnoredLines << "\n";
+    os << "Distinct Items              = " << getDistinctItems()
+       << (m_sketch ? " (estimated)" : "") << "\n";
+    if (m_sketch) {
+      os << "Sketch Memory               = " << m_sketch->getMemoryUsage() / 1024 << "KiB\n";
+    }
+
+    if (fit) {
+      os << "Zipf-Mandelbrot s           = " << fit->s << "\n";
+      os << "Zipf-Mandelbrot q           = " << fit->q << "\n";
+      os << "Log-likelihood              = " << fit->logLikelihood
+         << " (over " << fit->nRanks << " ranks)\n";
+      if (fit->s >= MAX_S - 0.01 || fit->s <= MIN_S + 0.01) {
+        os << "WARNING: fitted s is at the boundary of the search range\n";
+      }
+    }
+    else {
+      os << "Zipf-Mandelbrot fit         = not enough distinct items\n";
+    }
+
+    if (m_interArrival.getCount() > 0) {
+      auto n = m_interArrival.getCount();
+      double variance = n > 1 ? m_interArrivalM2 / (n - 1) : 0.0;
+      double mean = m_interArrival.getMean();
+      os << "Mean Inter-arrival Time     = " << mean << "ms\n";
+      os << "Inter-arrival Std Deviation = " << std::sqrt(variance) << "ms\n";
+      os << "Inter-arrival CoV           = " << (mean > 0 ? std::sqrt(variance) / mean : 0.0)
+         << " (1 for a Poisson process)\n";
+      os << "Inter-arrival p50/p90/p99   = " << m_interArrival.getPercentile(50) << "/"
+         << m_interArrival.getPercentile(90) << "/" << m_interArrival.getPercentile(99) << "ms\n";
+    }
+    else {
+      os << "Inter-arrival statistics    = no timestamps in input\n";
+    }
+
+    if (m_nRequests > 0) {
+      os << "Re-reference Ratio          = "
+         << m_reuseDistance.getCount() * 100.0 / m_nRequests << "%\n";
+    }
+    if (m_reuseDistance.getCount() > 0) {
+      os << "Reuse Distance p50/p90/p99  = " << m_reuseDistance.getPercentile(50) << "/"
+         << m_reuseDistance.getPercentile(90) << "/" << m_reuseDistance.getPercentile(99)
+         << " requests\n";
+    }
+    os << std::endl;
+  }
+
+  void
+  writeScenario(std::ostream& os, const std::optional<ZipfFit>& fit, std::size_t nPatterns) const
+  {
+    auto ranked = getRankedItems();
+
+    os << "#\n"
+       << "# CLIENT SCENARIO GENERATED BY ndn-traffic-analyzer\n"
+       << "#\n"
+       << "# * SOURCE: " << m_nRequests << " REQUESTS, " << getDistinctItems() << " DISTINCT ITEMS\n";
+    if (fit) {
+      // the client realizes q as an integer offset
+      os << "# * ZIPF-MANDELBROT FIT: s=" << fit->s << " q=" << fit->q << "\n"
+         << "# * PATTERNS ARE LISTED IN POPULARITY RANK ORDER, RUN WITH:\n"
+         << "#   ndn-traffic-client --mode 2 --zipffactor " << fit->s
+         << " --qvalue " << std::lround(fit->q);
+      if (m_interArrival.getCount() > 0) {
+        os << " --interval " << std::max(1L, std::lround(m_interArrival.getMean()));
+      }
+      os << " <this file>\n";
+    }
+    os << "#\n\n";
+
+    std::size_t nWritten = 0;
+    for (const auto& [name, count] : ranked) {
+      if (nWritten >= nPatterns) {
+        break;
+      }
+      if (!isValidConfigurationValue(name)) {
+        continue;
+      }
+      os << "TrafficPercentage=1\n"
+         << "Name=" << name << "\n"
+         << "##########\n";
+      nWritten++;
+    }
+  }
+
+private:
+  struct LocalityEntry
+  {
+    uint64_t itemHash = 0;
+    uint64_t lastIndex = 0;
+  };
+
+  static bool
+  parseLine(const std::string& line, std::optional<double>& timestamp, std::string_view& name)
+  {
+    std::string_view view(line);
+    while (!view.empty() && std::isspace(static_cast<unsigned char>(view.back()))) {
+      view.remove_suffix(1);
+    }
+    if (view.empty() || view[0] == '#') {
+      return false;
+    }
+
+    if (view[0] == '[') {
+      // log line, only Interest records carry request names
+      if (view.find("Sending Interest") == std::string_view::npos &&
+          view.find("Interest Received") == std::string_view::npos) {
+        return false;
+      }
+      auto pos = view.find(", Name=");
+      if (pos == std::string_view::npos) {
+        return false;
+      }
+      name = view.substr(pos + 7);
+      timestamp = parseTimestamp(view.substr(1, view.find(']') - 1));
+      return !name.empty();
+    }
+
+    auto space = view.find_first_of(" \t");
+    if (space == std::string_view::npos) {
+      name = view;
+      return true;
+    }
+    timestamp = parseTimestamp(view.substr(0, space));
+    if (!timestamp) {
+      name = view.substr(0, space);
+      return true;
+    }
+    name = view.substr(view.find_first_not_of(" \t", space));
+    return !name.empty();
+  }
+
+  static std::optional<double>
+  parseTimestamp(std::string_view str)
+  {
+    try {
+      std::size_t pos = 0;
+      double seconds = std::stod(std::string(str), &pos);
+      if (pos == str.size() && std::isfinite(seconds)) {
+        return seconds;
+      }
+    }
+    catch (const std::exception&) {
+    }
+    return std::nullopt;
+  }
+
+  static bool
+  isValidConfigurationValue(const std::string& value)
+  {
+    // same character set accepted by extractParameterAndValue()
+    static const std::string allowedCharacters = ":/+._-%@,";
+    return std::all_of(value.begin(), value.end(), [] (char c) {
+      return std::isalnum(static_cast<unsigned char>(c)) ||
+             allowedCharacters.find(c) != std::string::npos;
+    });
+  }
+
+  void
+  processRequest(const std::optional<double>& timestamp, std::string_view name)
+  {
+    uint64_t itemHash = hashBytes(name);
+    uint64_t index = m_nRequests++;
+    m_distinct.add(itemHash);
+
+    if (m_sketch) {
+      countInSketch(itemHash, name);
+    }
+    else {
+      m_exactItems[std::string(name)]++;
+    }
+
+    if (!m_localityTable.empty()) {
+      auto& entry = m_localityTable[mixHash(itemHash) & (m_localityTable.size() - 1)];
+      if (entry.itemHash == itemHash && entry.lastIndex < index) {
+        m_reuseDistance.record(static_cast<double>(index - entry.lastIndex));
+      }
+      entry.itemHash = itemHash;
+      entry.lastIndex = index;
+    }
+
+    if (timestamp) {
+      if (m_lastTimestamp) {
+        double delta = (*timestamp - *m_lastTimestamp) * 1000.0;
+        if (delta >= 0) {
+          m_interArrival.record(delta);
+          // Welford's online variance, m_interArrival keeps the running mean
+          double mean = m_interArrival.getMean();
+          m_interArrivalM2 += (delta - m_interArrivalMean) * (delta - mean);
+          m_interArrivalMean = mean;
+        }
+      }
+      m_lastTimestamp = timestamp;
+    }
+  }
+
+  void
+  countInSketch(uint64_t itemHash, std::string_view name)
+  {
+    uint64_t estimate = m_sketch->add(itemHash);
+    // a tracked item's estimate always exceeds its stored count, so only untracked items stop here
+    if (m_topItems.size() >= m_topK && estimate <= m_topByCount.begin()->first) {
+      return;
+    }
+
+    std::string key(name);
+    auto [it, isNew] = m_topItems.try_emplace(key, estimate);
+    if (!isNew) {
+      m_topByCount.erase({it->second, key});
+      it->second = estimate;
+    }
+    m_topByCount.emplace(estimate, std::move(key));
+
+    if (m_topItems.size() > m_topK) {
+      auto minIt = m_topByCount.begin();
+      m_topItems.erase(minIt->second);
+      m_topByCount.erase(minIt);
+    }
+  }
+
+  uint64_t
+  getDistinctItems() const
+  {
+    if (m_sketch) {
+      return static_cast<uint64_t>(std::llround(m_distinct.estimate()));
+    }
+    return m_exactItems.size();
+  }
+
+private:
+  static constexpr double MIN_S = 0.01;
+  static constexpr double MAX_S = 8.0;
+  static constexpr double MAX_Q = 10000.0;
+
+  std::optional<CountMinSketch> m_sketch;
+  std::unordered_map<std::string, uint64_t> m_exactItems;
+  std::unordered_map<std::string, uint64_t> m_topItems;
+  std::set<std::pair<uint64_t, std::string>> m_topByCount; // same entries as m_topItems, by count
+  std::size_t m_topK = 1000;
+  HyperLogLog m_distinct;
+
+  std::vector<LocalityEntry> m_localityTable;
+  Histogram m_reuseDistance;
+
+  std::optional<double> m_lastTimestamp;
+  Histogram m_interArrival; // milliseconds
+  double m_interArrivalMean = 0.0;
+  double m_interArrivalM2 = 0.0;
+
+  uint64_t m_nRequests = 0;
+  uint64_t m_nIgnoredLines = 0;
+};
+
+} // namespace ndntg
+
+namespace po = boost::program_options;
+
+static void
+usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
+{
+  os << "Usage: " << programName << " [options] <Trace_File>...\n"
+     << "\n"
+     << "Characterize a request workload and generate a matching client scenario.\n"
+     << "Each Trace_File is either an ndn-traffic-client/ndn-traffic-server log or a plain\n"
+     << "trace with one name per line, optionally preceded by a Unix timestamp in seconds.\n"
+     << "Use '-' to read from the standard input.\n"
+     << "\n"
+     << desc;
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::vector<std::string> traceFiles;
+  std::string outputFile;
+
+  po::options_description visibleOptions("Options");
+  visibleOptions.add_options()
+    ("help,h",     "print this help message and exit")
+    ("output,o",   po::value<std::string>(&outputFile)->default_value("scenario.conf"),
+                   "write the generated client scenario to this file")
+    ("patterns,p", po::value<std::size_t>()->default_value(100),
+                   "maximum number of patterns (most popular items) in the scenario")
+    ("top-k,k",    po::value<std::size_t>()->default_value(1000),
+                   "number of most popular items tracked and used for fitting")
+    ("sketch,s",   po::bool_switch(), "count with a Count-Min sketch (bounded memory) instead of exactly")
+    ("sketch-width", po::value<std::size_t>()->default_value(1 << 20), "Count-Min sketch width")
+    ("sketch-depth", po::value<std::size_t>()->default_value(4), "Count-Min sketch depth")
+    ("locality-table", po::value<unsigned>()->default_value(20),
+                   "log2 of the number of entries used for reuse distance tracking (0 to disable)")
+    ;
+
+  po::options_description hiddenOptions;
+  hiddenOptions.add_options()
+    ("trace-file", po::value<std::vector<std::string>>(&traceFiles))
+    ;
+
+  po::positional_options_description posOptions;
+  posOptions.add("trace-file", -1);
+
+  po::options_description allOptions;
+  allOptions.add(visibleOptions).add(hiddenOptions);
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(allOptions).positional(posOptions).run(), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+  catch (const boost::bad_any_cast& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    usage(std::cout, argv[0], visibleOptions);
+    return 0;
+  }
+
+  if (traceFiles.empty()) {
+    usage(std::cerr, argv[0], visibleOptions);
+    return 2;
+  }
+
+  ndntg::NdnTrafficAnalyzer analyzer;
+  analyzer.setTopK(vm["top-k"].as<std::size_t>());
+
+  if (vm["sketch"].as<bool>()) {
+    analyzer.setSketchMode(vm["sketch-width"].as<std::size_t>(), vm["sketch-depth"].as<std::size_t>());
+  }
+
+  auto localityBits = vm["locality-table"].as<unsigned>();
+  if (localityBits > 32) {
+    std::cerr << "ERROR: the argument for option '--locality-table' cannot exceed 32\n";
+    return 2;
+  }
+  if (localityBits > 0) {
+    analyzer.setLocalityTableSize(localityBits);
+  }
+
+  for (const auto& file : traceFiles) {
+    if (file == "-") {
+      analyzer.processStream(std::cin);
+      continue;
+    }
+    std::ifstream is(file);
+    if (!is || !analyzer.processStream(is)) {
+      std::cerr << "ERROR: Unable to read trace file: " << file << std::endl;
+      return 2;
+    }
+  }
+
+  std::vector<uint64_t> counts;
+  for (const auto& item : analyzer.getRankedItems()) {
+    counts.push_back(item.second);
+  }
+  auto fit = ndntg::NdnTrafficAnalyzer::fitZipfMandelbrot(counts);
+  analyzer.printReport(std::cout, fit);
+
+  std::ofstream scenario(outputFile);
+  if (!scenario) {
+    std::cerr << "ERROR: Unable to open output file: " << outputFile << std::endl;
+    return 1;
+  }
+  analyzer.writeScenario(scenario, fit, vm["patterns"].as<std::size_t>());
+  std::cout << "Client scenario written to: " << outputFile << std::endl;
+
+  return 0;
+}
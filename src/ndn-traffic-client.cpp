@@ -18,24 +18,46 @@
  * Author: Jerald Paul Abraham <jeraldabraham@email.arizona.edu>
  */
 
+#include "content-header.hpp"
+#include "fast-signer.hpp"
+#include "histogram.hpp"
+#include "pattern-selector.hpp"
+#include "sampler-cache.hpp"
+#include "sketch.hpp"
+#include "transport.hpp"
 #include "util.hpp"
+#include "value-mix.hpp"
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/transform/base64-encode.hpp>
+#include <ndn-cxx/security/transform/buffer-source.hpp>
+#include <ndn-cxx/security/transform/stream-sink.hpp>
+#include <ndn-cxx/security/validator-config.hpp>
 #include <ndn-cxx/util/random.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <boost/core/noncopyable.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options/options_description.hpp>
@@ -83,6 +105,11 @@ namespace time = ndn::time;
 class NdnTrafficClient : boost::noncopyable
 {
 public:
+  enum class FaceDispatch {
+    ROUND_ROBIN,
+    NAME_HASH,
+  };
+
   explicit
   NdnTrafficClient(std::string configFile)
     : m_configurationFile(std::move(configFile))
@@ -120,6 +147,67 @@ public:
     m_wantVerbose = true;
   }
 
+  void
+  setFaceUris(std::vector<std::string> uris, FaceDispatch dispatch)
+  {
+    m_faceUris = std::move(uris);
+    m_faceDispatch = dispatch;
+  }
+
+  /**
+   * @brief Coalesces the Interests sent in one event loop iteration into batched socket writes.
+   */
+  void
+  setBatching(const BatchingOptions& options)
+  {
+    m_batchingOptions = options;
+  }
+
+  void
+  setSamplerCache(std::string directory, unsigned nThreads)
+  {
+    m_samplerCacheDirectory = std::move(directory);
+    m_nSamplerThreads = std::max(nThreads, 1U);
+  }
+
+  /**
+   * @brief Signs Interests on @p nThreads threads instead of the event loop thread (0 = off).
+   */
+  void
+  setSigningThreads(unsigned nThreads)
+  {
+    m_nSigningThreads = nThreads;
+  }
+
+  /**
+   * @brief Validates @p percentage percent of the received Data against the trust policy in @p configFile.
+   *
+   * Every validated Data goes through the whole policy on one of @p nThreads verifier threads;
+   * each verifier caches the certificates it has verified, so the chain of a known signer is not
+   * retrieved and verified again.
+   */
+  void
+  setDataValidation(std::string configFile, double percentage, unsigned nThreads)
+  {
+    m_validatorConfigFile = std::move(configFile);
+    m_validationPercentage = percentage;
+    m_nVerifiers = nThreads;
+  }
+
+  /**
+   * @brief Requests the @p nItems most popular patterns (0 = all) once before the measured workload.
+   * @param window maximum number of outstanding preload Interests
+   * @param rate maximum preload Interests per second (0 = limited by the window only)
+   */
+  void
+  setPreload(std::size_t nItems, std::size_t window, double rate)
+  {
+    m_wantPreload = true;
+    m_nPreloadItems = nItems;
+    m_preloadWindow = std::max<std::size_t>(window, 1);
+    m_preloadRate = rate;
+  }
+
   int
   run()
   {
@@ -146,23 +234,118 @@ public:
       return 0;
     }
 
+    if (!prepareInterestSigning()) {
+      return 2;
+    }
+    buildInterestVariants();
+
+    try {
+      if (m_faceUris.empty() && m_batchingOptions.isEnabled()) {
+        m_faceUris.push_back(getDefaultTransportUri());
+      }
+      if (m_faceUris.empty()) {
+        m_faces.push_back(std::make_unique<ndn::Face>(m_io));
+      }
+      for (const auto& uri : m_faceUris) {
+        if (m_batchingOptions.isEnabled()) {
+          auto transport = makeBatchingTransport(uri, m_batchingOptions);
+          m_batchingTransports.push_back(transport);
+          m_faces.push_back(std::make_unique<ndn::Face>(std::move(transport), m_io));
+        }
+        else {
+          m_faces.push_back(std::make_unique<ndn::Face>(makeTransport(uri), m_io));
+        }
+        m_logger.log("Using forwarder face #" + std::to_string(m_faces.size()) + ": " + uri, true, false);
+      }
+    }
+    catch (const std::exception& e) {
+      m_logger.log("ERROR: "s + e.what(), false, true);
+      return 2;
+    }
+    m_faceStatistics.resize(m_faces.size());
+
+    if (!m_validatorConfigFile.empty()) {
+      // missing certificates are retrieved through the face of the verifier that needs them
+      try {
+        for (unsigned i = 0; i < m_nVerifiers; i++) {
+          m_verifiers.push_back(std::make_unique<Verifier>());
+          m_verifiers.back()->validator.load(m_validatorConfigFile);
+        }
+      }
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: cannot load the validator configuration: "s + e.what(), false, true);
+        m_verifiers.clear();
+        return 2;
+      }
+    }
+
+    std::vector<double> weights;
+    for (const auto& pattern : m_trafficPatterns) {
+      weights.push_back(pattern.m_trafficPercentage);
+    }
+    m_patternSelector.build(weights);
+    m_logger.log("Pattern selection: "s +
+                 PatternSelector::getImplementationName(m_patternSelector.getImplementation()), true, false);
+
+    if (mode == 2) {
+      SamplerCache cache(m_samplerCacheDirectory);
+      m_zipfDistribution = cache.makeZipfMandelbrot(zipffactor, static_cast<uint32_t>(qvalue),
+                                                    nprefix, m_nSamplerThreads, m_logger);
+    }
+
+    for (const auto& verifierPtr : m_verifiers) {
+      auto& verifier = *verifierPtr;
+      verifier.thread = std::thread([this, &verifier] {
+        try {
+          verifier.face.processEvents(time::milliseconds::zero(), true);
+        }
+        catch (const std::exception& e) {
+          m_logger.log("ERROR: "s + e.what(), true, true);
+          boost::asio::post(m_io, [this] {
+            m_hasError = true;
+            stop();
+          });
+        }
+      });
+    }
+
     m_signalSet.async_wait([this] (auto&&...) { stop(); });
 
-    boost::asio::steady_timer timer(m_io, m_interestInterval);
-    timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
+    boost::asio::steady_timer timer(m_io);
+    auto startWorkload = [this, &timer] {
+      m_startTime = time::steady_clock::now();
+      timer.expires_after(m_interestInterval);
+      timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
+    };
+    if (m_wantPreload) {
+      startPreload(startWorkload);
+    }
+    else {
+      startWorkload();
+    }
 
     try {
-      m_face.processEvents();
+      // all faces share m_io, so running the event loop of one of them serves all
+      m_faces.front()->processEvents();
       return m_hasError ? 1 : 0;
     }
     catch (const std::exception& e) {
       m_logger.log("ERROR: "s + e.what(), true, true);
+      stopVerifiers();
       m_io.stop();
       return 1;
     }
   }
 
 private:
+  struct InFlightName
+  {
+    ndn::Name name;
+    // prototype the Interest was copied from, so that a collision also has the same CanBePrefix and MustBeFresh
+    std::size_t variant = 0;
+    int localRef = 0; // zero once the Interest is satisfied, Nack'd or timed out
+  };
+
   class InterestTrafficConfiguration
   {
   public:
@@ -179,17 +362,24 @@ private:
       if (m_nameAppendSeqNum) {
         os << "NameAppendSequenceNumber=" << *m_nameAppendSeqNum << ", ";
       }
-      if (m_canBePrefix) {
-        os << "CanBePrefix=" << m_canBePrefix << ", ";
+      if (m_canBePrefixPercentage > 0.0) {
+        os << "CanBePrefixPercentage=" << m_canBePrefixPercentage << ", ";
       }
-      if (m_mustBeFresh) {
-        os << "MustBeFresh=" << m_mustBeFresh << ", ";
+      if (m_mustBeFreshPercentage > 0.0) {
+        os << "MustBeFreshPercentage=" << m_mustBeFreshPercentage << ", ";
       }
       if (m_nonceDuplicationPercentage > 0) {
         os << "NonceDuplicationPercentage=" << m_nonceDuplicationPercentage << ", ";
       }
-      if (m_interestLifetime >= 0_ms) {
-        os << "InterestLifetime=" << m_interestLifetime.count() << ", ";
+      if (m_nameCollisionPercentage > 0) {
+        os << "NameCollisionPercentage=" << m_nameCollisionPercentage << ", ";
+        os << "NameCollisionWindow=" << m_nameCollisionWindow << ", ";
+      }
+      if (!m_interestLifetimes.empty()) {
+        os << "InterestLifetime=" << formatValueMix(m_interestLifetimes) << ", ";
+      }
+      if (!m_hopLimits.empty()) {
+        os << "HopLimit=" << formatValueMix(m_hopLimits) << ", ";
       }
       if (m_nextHopFaceId > 0) {
         os << "NextHopFaceId=" << m_nextHopFaceId << ", ";
@@ -197,6 +387,12 @@ private:
       if (m_expectedContent) {
         os << "ExpectedContent=" << *m_expectedContent << ", ";
       }
+      if (m_applicationParametersSize > 0) {
+        os << "ApplicationParametersSize=" << m_applicationParametersSize << ", ";
+      }
+      if (!m_interestSigning.empty()) {
+        os << "InterestSigning=" << m_interestSigning << ", ";
+      }
 
       auto str = os.str();
       str = str.substr(0, str.length() - 2); // remove suffix ", "
@@ -237,16 +433,42 @@ private:
         m_nameAppendSeqNum = std::stoull(value);
       }
       else if (parameter == "CanBePrefix") {
-        m_canBePrefix = parseBoolean(value);
+        m_canBePrefixPercentage = parseBoolean(value) ? 100.0 : 0.0;
+      }
+      else if (parameter == "CanBePrefixPercentage" || parameter == "MustBeFreshPercentage") {
+        double percentage = std::stod(value);
+        if (!(percentage >= 0.0 && percentage <= 100.0)) {
+          logger.log("Line " + std::to_string(lineNumber) + " - " + parameter + " must be between 0 and 100",
+                     false, true);
+          return false;
+        }
+        (parameter == "CanBePrefixPercentage" ? m_canBePrefixPercentage : m_mustBeFreshPercentage) = percentage;
       }
       else if (parameter == "MustBeFresh") {
-        m_mustBeFresh = parseBoolean(value);
+        m_mustBeFreshPercentage = parseBoolean(value) ? 100.0 : 0.0;
       }
       else if (parameter == "NonceDuplicationPercentage") {
         m_nonceDuplicationPercentage = std::stoul(value);
       }
-      else if (parameter == "InterestLifetime") {
-        m_interestLifetime = time::milliseconds(std::stoul(value));
+      else if (parameter == "NameCollisionPercentage") {
+        m_nameCollisionPercentage = std::stoul(value);
+      }
+      else if (parameter == "NameCollisionWindow") {
+        m_nameCollisionWindow = std::stoul(value);
+        if (m_nameCollisionWindow == 0) {
+          logger.log("Line " + std::to_string(lineNumber) + " - NameCollisionWindow must be positive",
+                     false, true);
+          return false;
+        }
+      }
+      else if (parameter == "InterestLifetime" || parameter == "HopLimit") {
+        auto& mix = parameter == "InterestLifetime" ? m_interestLifetimes : m_hopLimits;
+        uint64_t maxValue = parameter == "HopLimit" ? 255 : std::numeric_limits<int64_t>::max();
+        if (!parseValueMix(value, maxValue, mix)) {
+          logger.log("Line " + std::to_string(lineNumber) + " - " + parameter +
+                     " must be <value> or <value>@<weight>,<value>@<weight>,...", false, true);
+          return false;
+        }
       }
       else if (parameter == "NextHopFaceId") {
         m_nextHopFaceId = std::stoull(value);
@@ -254,6 +476,17 @@ private:
       else if (parameter == "ExpectedContent") {
         m_expectedContent = value;
       }
+      else if (parameter == "ApplicationParametersSize") {
+        m_applicationParametersSize = std::stoul(value);
+      }
+      else if (parameter == "InterestSigning") {
+        if (value != "DigestSha256" && value != "HmacSha256" && value != "Ecdsa") {
+          logger.log("Line " + std::to_string(lineNumber) +
+                     " - InterestSigning must be DigestSha256, HmacSha256, or Ecdsa", false, true);
+          return false;
+        }
+        m_interestSigning = value;
+      }
       else {
         logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " + parameter,
                    false, true);
@@ -262,7 +495,7 @@ private:
     }
 
     bool
-    checkTrafficDetailCorrectness() const
+    checkTrafficDetailCorrectness(Logger&) const
     {
       return true;
     }
@@ -272,29 +505,216 @@ private:
     std::string m_name;
     std::optional<std::size_t> m_nameAppendBytes;
     std::optional<uint64_t> m_nameAppendSeqNum;
-    bool m_canBePrefix = false;
-    bool m_mustBeFresh = false;
+    double m_canBePrefixPercentage = 0.0;
+    double m_mustBeFreshPercentage = 0.0;
     unsigned m_nonceDuplicationPercentage = 0;
-    time::milliseconds m_interestLifetime = -1_ms;
+    unsigned m_nameCollisionPercentage = 0;
+    std::size_t m_nameCollisionWindow = 16;
+    ValueMix m_interestLifetimes; // milliseconds, empty for the default lifetime
+    ValueMix m_hopLimits; // empty for no HopLimit
     uint64_t m_nextHopFaceId = 0;
     std::optional<std::string> m_expectedContent;
+    std::size_t m_applicationParametersSize = 0;
+    std::string m_interestSigning;
+
+    // generated once when traffic starts
+    std::vector<ndn::Interest> m_variants; // one prototype per combination of Interest attributes
+    PatternSelector m_variantSelector;
+    double m_variantTotalWeight = 0.0;
+    std::vector<uint8_t> m_applicationParameters;
+    std::string m_signingInfo;
+    std::optional<FastSigner> m_signer; // used by the event loop thread only
 
     uint64_t m_nInterestsSent = 0;
     uint64_t m_nInterestsReceived = 0;
     uint64_t m_nNacks = 0;
     uint64_t m_nContentInconsistencies = 0;
+    uint64_t m_nContentHeaders = 0;
+    uint64_t m_nStaleVersions = 0;
+    // responses without a ContentHeader have an unknown freshness
+    uint64_t m_nFreshResponses = 0;
+    uint64_t m_nStaleResponses = 0;
+    uint64_t m_nFreshnessViolations = 0; // stale responses to MustBeFresh Interests
+    // with name collisions, ring of the names of the last NameCollisionWindow Interests, indexed by LocalID
+    std::vector<InFlightName> m_inFlightNames;
+    uint64_t m_nCollisions = 0;
+    uint64_t m_nCollisionMisses = 0;
+    uint64_t m_nCollisionsSatisfied = 0;
+    // global byte totals are summed over the patterns when reporting
+    uint64_t m_nInterestBytesSent = 0;
+    uint64_t m_nDataBytesReceived = 0;
+    uint64_t m_nContentBytesReceived = 0;
+    Histogram m_contentSize; // bytes
+
+    // RFC 3550 interarrival jitter, in milliseconds, over the Data of this pattern in arrival order
+    double m_jitter = 0;
+    std::optional<time::steady_clock::time_point> m_lastDataSentTime;
+    time::steady_clock::time_point m_lastDataReceiveTime;
+    // delivery order in send order, with a window of the last 64 keys below the highest one received
+    std::optional<uint64_t> m_highestDeliveryKey;
+    uint64_t m_deliveryWindow = 0; // bit i is set if key (highest - i) was delivered
+    uint64_t m_nOutOfOrder = 0;
+    uint64_t m_nDuplicates = 0;
 
     // RTT is stored as milliseconds with fractional sub-milliseconds precision
     double m_minimumInterestRoundTripTime = std::numeric_limits<double>::max();
     double m_maximumInterestRoundTripTime = 0;
     double m_totalInterestRoundTripTime = 0;
+    Histogram m_signingTime; // microseconds
+
+    uint64_t m_nValidated = 0;
+    uint64_t m_nValidationFailures = 0;
+    Histogram m_validationTime; // milliseconds, from Data reception to the validation result
+    Histogram m_validatedResponseTime; // milliseconds, from sending the Interest to the validation result
+  };
+
+  struct FaceStatistics
+  {
+    uint64_t nInterestsSent = 0;
+    uint64_t nResponses = 0;
+    uint64_t nNacks = 0;
+    uint64_t nTimeouts = 0;
+    Histogram rtt; // milliseconds
+  };
+
+  /**
+   * @brief State owned by one verifier thread.
+   *
+   * Each verifier has its own io_context, Face, and ValidatorConfig, so that verifying signatures
+   * and retrieving certificates never run on the event loop thread that sends the Interests.
+   */
+  class Verifier : boost::noncopyable
+  {
+  public:
+    boost::asio::io_context io;
+    ndn::Face face{io};
+    ndn::security::ValidatorConfig validator{face};
+    std::thread thread;
+  };
+
+  void
+  logFaceStatistics()
+  {
+    using std::to_string;
+
+    m_logger.log("== Face Report ==\n", false, true);
+    for (std::size_t faceId = 0; faceId < m_faceStatistics.size(); faceId++) {
+      const auto& stats = m_faceStatistics[faceId];
+      m_logger.log("Face #" + to_string(faceId + 1) + " (" + m_faceUris.at(faceId) + ")", false, true);
+      m_logger.log("Total Interests Sent        = " + to_string(stats.nInterestsSent), false, true);
+      m_logger.log("Total Responses Received    = " + to_string(stats.nResponses), false, true);
+      m_logger.log("Total Nacks Received        = " + to_string(stats.nNacks), false, true);
+      m_logger.log("Total Timeouts              = " + to_string(stats.nTimeouts), false, true);
+      m_logger.log("Round Trip Time p50/p90/p99 = " + to_string(stats.rtt.getPercentile(50)) + "/" +
+                   to_string(stats.rtt.getPercentile(90)) + "/" +
+                   to_string(stats.rtt.getPercentile(99)) + "ms\n", false, true);
+    }
+  }
+
+  struct SizeStatistics
+  {
+    uint64_t nResponses = 0;
+    uint64_t nContentBytes = 0;
+    Histogram rtt; // milliseconds
   };
 
+  // responses are bucketed by content size in powers of two: [0, 64), [64, 128), ..., [8192, inf)
+  static constexpr std::size_t N_SIZE_BUCKETS = 9;
+
+  static std::size_t
+  getSizeBucket(std::size_t contentSize)
+  {
+    std::size_t bucket = 0;
+    for (contentSize >>= 6; contentSize > 0 && bucket < N_SIZE_BUCKETS - 1; contentSize >>= 1) {
+      bucket++;
+    }
+    return bucket;
+  }
+
+  void
+  logSizeStatistics()
+  {
+    using std::to_string;
+
+    double elapsed = time::duration_cast<time::nanoseconds>(time::steady_clock::now() - m_startTime).count() / 1e9;
+    m_logger.log("== Response Size Report ==\n", false, true);
+    for (std::size_t bucket = 0; bucket < N_SIZE_BUCKETS; bucket++) {
+      const auto& stats = m_sizeStatistics[bucket];
+      if (stats.nResponses == 0) {
+        continue;
+      }
+      auto lower = bucket == 0 ? 0 : std::size_t(64) << (bucket - 1);
+      auto upper = bucket == N_SIZE_BUCKETS - 1 ? "inf"s : to_string(std::size_t(64) << bucket);
+      double goodput = elapsed > 0.0 ? stats.nContentBytes * 8 / elapsed / 1000 : 0.0;
+      m_logger.log("Content Size [" + to_string(lower) + ", " + upper + ") bytes", false, true);
+      m_logger.log("Total Responses Received    = " + to_string(stats.nResponses), false, true);
+      m_logger.log("Goodput                     = " + to_string(goodput) + "kbit/s", false, true);
+      m_logger.log("Round Trip Time p50/p90/p99 = " + to_string(stats.rtt.getPercentile(50)) + "/" +
+                   to_string(stats.rtt.getPercentile(90)) + "/" +
+                   to_string(stats.rtt.getPercentile(99)) + "ms\n", false, true);
+    }
+  }
+
+  void
+  logSigningTime(const Histogram& signingTime)
+  {
+    using std::to_string;
+
+    m_logger.log("Interest Signing Time mean/p50/p99 = " + to_string(signingTime.getMean()) + "/" +
+                 to_string(signingTime.getPercentile(50)) + "/" +
+                 to_string(signingTime.getPercentile(99)) + "us", false, true);
+  }
+
+  void
+  logValidation(uint64_t nValidated, uint64_t nFailures, const Histogram& validationTime,
+                const Histogram& responseTime)
+  {
+    using std::to_string;
+
+    auto formatTime = [] (const Histogram& histogram) {
+      return to_string(histogram.getMean()) + "/" + to_string(histogram.getPercentile(50)) + "/" +
+             to_string(histogram.getPercentile(99)) + "ms";
+    };
+    m_logger.log("Total Data Validated        = " + to_string(nValidated), false, true);
+    m_logger.log("Total Validation Failures   = " + to_string(nFailures), false, true);
+    if (validationTime.getCount() > 0) {
+      m_logger.log("Validation Time mean/p50/p99 = " + formatTime(validationTime), false, true);
+      m_logger.log("Validated Response Time mean/p50/p99 = " + formatTime(responseTime), false, true);
+    }
+  }
+
+  void
+  logFreshness(uint64_t nFresh, uint64_t nStale, uint64_t nUnknown, uint64_t nViolations)
+  {
+    using std::to_string;
+
+    m_logger.log("Fresh/Stale/Unknown Data    = " + to_string(nFresh) + "/" + to_string(nStale) + "/" +
+                 to_string(nUnknown), false, true);
+    m_logger.log("MustBeFresh Violations      = " + to_string(nViolations), false, true);
+  }
+
+  static double
+  getMbitPerSecond(uint64_t nBytes, double seconds)
+  {
+    return seconds > 0.0 ? nBytes * 8 / seconds / 1e6 : 0.0;
+  }
+
   void
   logStatistics()
   {
     using std::to_string;
 
+    double elapsed = time::duration_cast<time::nanoseconds>(time::steady_clock::now() - m_startTime).count() / 1e9;
+    uint64_t nInterestBytesSent = 0;
+    uint64_t nDataBytesReceived = 0;
+    uint64_t nContentBytesReceived = 0;
+    for (const auto& pattern : m_trafficPatterns) {
+      nInterestBytesSent += pattern.m_nInterestBytesSent;
+      nDataBytesReceived += pattern.m_nDataBytesReceived;
+      nContentBytesReceived += pattern.m_nContentBytesReceived;
+    }
+    double goodput = getMbitPerSecond(nContentBytesReceived, elapsed);
+
     m_logger.log("\n\n== Traffic Report ==\n", false, true);
     m_logger.log("Total Traffic Pattern Types = " + to_string(m_trafficPatterns.size()), false, true);
     m_logger.log("Total Interests Sent        = " + to_string(m_nInterestsSent), false, true);
@@ -314,9 +734,89 @@ private:
       inconsistency = m_nContentInconsistencies * 100.0 / m_nInterestsReceived;
     }
     m_logger.log("Total Data Inconsistency    = " + to_string(inconsistency) + "%", false, true);
+    if (m_nContentHeaders > 0) {
+      m_logger.log("Total Stale Versions        = " + to_string(m_nStaleVersions) + " of " +
+                   to_string(m_nContentHeaders), false, true);
+      uint64_t nFresh = 0;
+      uint64_t nStale = 0;
+      uint64_t nViolations = 0;
+      for (const auto& pattern : m_trafficPatterns) {
+        nFresh += pattern.m_nFreshResponses;
+        nStale += pattern.m_nStaleResponses;
+        nViolations += pattern.m_nFreshnessViolations;
+      }
+      logFreshness(nFresh, nStale, m_nInterestsReceived - m_nContentHeaders, nViolations);
+    }
+    Histogram signingTime;
+    for (const auto& pattern : m_trafficPatterns) {
+      signingTime.merge(pattern.m_signingTime);
+    }
+    if (signingTime.getCount() > 0) {
+      logSigningTime(signingTime);
+    }
+    if (std::any_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                    [] (const auto& pattern) { return pattern.m_nameCollisionPercentage > 0; })) {
+      uint64_t nCollisions = 0;
+      uint64_t nCollisionsSatisfied = 0;
+      for (const auto& pattern : m_trafficPatterns) {
+        nCollisions += pattern.m_nCollisions;
+        nCollisionsSatisfied += pattern.m_nCollisionsSatisfied;
+      }
+      m_logger.log("Total Name Collisions Sent  = " + to_string(nCollisions) + " (" +
+                   to_string(nCollisionsSatisfied) + " satisfied)", false, true);
+    }
+    if (!m_verifiers.empty()) {
+      uint64_t nValidated = 0;
+      uint64_t nValidationFailures = 0;
+      Histogram validationTime;
+      Histogram validatedResponseTime;
+      for (const auto& pattern : m_trafficPatterns) {
+        nValidated += pattern.m_nValidated;
+        nValidationFailures += pattern.m_nValidationFailures;
+        validationTime.merge(pattern.m_validationTime);
+        validatedResponseTime.merge(pattern.m_validatedResponseTime);
+      }
+      logValidation(nValidated, nValidationFailures, validationTime, validatedResponseTime);
+    }
+    uint64_t nOutOfOrder = 0;
+    uint64_t nDuplicates = 0;
+    double jitter = 0.0;
+    std::size_t nJitterPatterns = 0;
+    for (const auto& pattern : m_trafficPatterns) {
+      nOutOfOrder += pattern.m_nOutOfOrder;
+      nDuplicates += pattern.m_nDuplicates;
+      if (pattern.m_nInterestsReceived > 1) {
+        jitter += pattern.m_jitter;
+        nJitterPatterns++;
+      }
+    }
+    // jitter is only defined within a pattern's stream, so the overall value is their mean
+    if (nJitterPatterns > 0) {
+      jitter /= nJitterPatterns;
+    }
+    m_logger.log("Mean Interarrival Jitter    = " + to_string(jitter) + "ms", false, true);
+    m_logger.log("Out-of-Order/Duplicate Data = " + to_string(nOutOfOrder) + "/" + to_string(nDuplicates),
+                 false, true);
+    m_logger.log("Total Interest Bytes Sent   = " + to_string(nInterestBytesSent), false, true);
+    m_logger.log("Total Data Bytes Received   = " + to_string(nDataBytesReceived) + " (" +
+                 to_string(getMbitPerSecond(nDataBytesReceived, elapsed)) + "Mbit/s)", false, true);
+    m_logger.log("Total Content Bytes Received = " + to_string(nContentBytesReceived), false, true);
+    m_logger.log("Goodput                     = " + to_string(goodput) + "Mbit/s", false, true);
     m_logger.log("Total Round Trip Time       = " + to_string(m_totalInterestRoundTripTime) + "ms", false, true);
     m_logger.log("Average Round Trip Time     = " + to_string(average) + "ms\n", false, true);
 
+    if (!m_batchingTransports.empty()) {
+      BatchingCounters counters;
+      for (const auto& transport : m_batchingTransports) {
+        counters += transport->getCounters();
+      }
+      double batchPackets = counters.nBatches > 0 ? double(counters.nPackets) / counters.nBatches : 0.0;
+      double batchBytes = counters.nBatches > 0 ? double(counters.nBytes) / counters.nBatches : 0.0;
+      m_logger.log("Total Write Batches         = " + to_string(counters.nBatches), false, true);
+      m_logger.log("Average Batch Size          = " + to_string(batchPackets) + " packets, " +
+                   to_string(batchBytes) + " bytes\n", false, true);
+    }
+
     //generate log.csv for overall status
     ofstream outdata;
     outdata.open("log.csv");
@@ -324,8 +824,8 @@ private:
       cerr << "Error FILE" << endl;
     }
 
-    outdata << "PatternID,InterestSent,ResponsesReceived,Nacks,InterestLoss(%),Inconsistency(%),TotalRTT(ms),AverageRTT(ms)" << endl;
-    outdata << "Overall," << to_string(m_nInterestsSent) << "," << to_string(m_nInterestsReceived) << "," << to_string(m_nNacks) << "," << to_string(loss) << "," << to_string(inconsistency) << "," << to_string(m_totalInterestRoundTripTime) << "," << to_string(average) << "," << endl;
+    outdata << "PatternID,InterestSent,ResponsesReceived,Nacks,InterestLoss(%),Inconsistency(%),TotalRTT(ms),AverageRTT(ms),InterestBytes,DataBytes,ContentBytes,Goodput(Mbit/s),Jitter(ms),OutOfOrder,Duplicates" << endl;
+    outdata << "Overall," << to_string(m_nInterestsSent) << "," << to_string(m_nInterestsReceived) << "," << to_string(m_nNacks) << "," << to_string(loss) << "," << to_string(inconsistency) << "," << to_string(m_totalInterestRoundTripTime) << "," << to_string(average) << "," << to_string(nInterestBytesSent) << "," << to_string(nDataBytesReceived) << "," << to_string(nContentBytesReceived) << "," << to_string(goodput) << "," << to_string(jitter) << "," << to_string(nOutOfOrder) << "," << to_string(nDuplicates) << endl;
 
     for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
       const auto& pattern = m_trafficPatterns[patternId];
@@ -349,14 +849,55 @@ private:
         inconsistency = pattern.m_nContentInconsistencies * 100.0 / pattern.m_nInterestsReceived;
       }
       m_logger.log("Total Data Inconsistency    = " + to_string(inconsistency) + "%", false, true);
+      if (pattern.m_nContentHeaders > 0) {
+        m_logger.log("Total Stale Versions        = " + to_string(pattern.m_nStaleVersions) + " of " +
+                     to_string(pattern.m_nContentHeaders), false, true);
+        logFreshness(pattern.m_nFreshResponses, pattern.m_nStaleResponses,
+                     pattern.m_nInterestsReceived - pattern.m_nContentHeaders, pattern.m_nFreshnessViolations);
+      }
+      if (pattern.m_signingTime.getCount() > 0) {
+        logSigningTime(pattern.m_signingTime);
+      }
+      if (pattern.m_nameCollisionPercentage > 0) {
+        m_logger.log("Name Collisions Sent        = " + to_string(pattern.m_nCollisions), false, true);
+        m_logger.log("Name Collisions Satisfied   = " + to_string(pattern.m_nCollisionsSatisfied), false, true);
+        m_logger.log("No Outstanding Name to Reuse = " + to_string(pattern.m_nCollisionMisses), false, true);
+      }
+      if (!m_verifiers.empty()) {
+        logValidation(pattern.m_nValidated, pattern.m_nValidationFailures,
+                      pattern.m_validationTime, pattern.m_validatedResponseTime);
+      }
+      goodput = getMbitPerSecond(pattern.m_nContentBytesReceived, elapsed);
+      m_logger.log("Interarrival Jitter         = " + to_string(pattern.m_jitter) + "ms", false, true);
+      m_logger.log("Out-of-Order/Duplicate Data = " + to_string(pattern.m_nOutOfOrder) + "/" +
+                   to_string(pattern.m_nDuplicates), false, true);
+      m_logger.log("Total Interest Bytes Sent   = " + to_string(pattern.m_nInterestBytesSent), false, true);
+      m_logger.log("Total Data Bytes Received   = " + to_string(pattern.m_nDataBytesReceived) + " (" +
+                   to_string(getMbitPerSecond(pattern.m_nDataBytesReceived, elapsed)) + "Mbit/s)", false, true);
+      m_logger.log("Total Content Bytes Received = " + to_string(pattern.m_nContentBytesReceived), false, true);
+      m_logger.log("Goodput                     = " + to_string(goodput) + "Mbit/s", false, true);
+      if (pattern.m_contentSize.getCount() > 0) {
+        const auto& size = pattern.m_contentSize;
+        m_logger.log("Content Size min/mean/p50/p99/max = " + to_string(size.getMin()) + "/" +
+                     to_string(size.getMean()) + "/" + to_string(size.getPercentile(50)) + "/" +
+                     to_string(size.getPercentile(99)) + "/" + to_string(size.getMax()) + " bytes", false, true);
+      }
       m_logger.log("Total Round Trip Time       = " +
                    to_string(pattern.m_totalInterestRoundTripTime) + "ms", false, true);
       m_logger.log("Average Round Trip Time     = " + to_string(average) + "ms\n", false, true);
 
       //per traffic log
-      outdata << to_string(patternId + 1) << "," << to_string(m_trafficPatterns[patternId].m_nInterestsSent) << "," << to_string(m_trafficPatterns[patternId].m_nInterestsReceived) << "," << to_string(m_trafficPatterns[patternId].m_nNacks) << "," << to_string(loss) << "," << to_string(inconsistency) << "," << to_string(m_trafficPatterns[patternId].m_totalInterestRoundTripTime) << "," << to_string(average) << endl;     
+      outdata << to_string(patternId + 1) << "," << to_string(m_trafficPatterns[patternId].m_nInterestsSent) << "," << to_string(m_trafficPatterns[patternId].m_nInterestsReceived) << "," << to_string(m_trafficPatterns[patternId].m_nNacks) << "," << to_string(loss) << "," << to_string(inconsistency) << "," << to_string(m_trafficPatterns[patternId].m_totalInterestRoundTripTime) << "," << to_string(average) << "," << to_string(pattern.m_nInterestBytesSent) << "," << to_string(pattern.m_nDataBytesReceived) << "," << to_string(pattern.m_nContentBytesReceived) << "," << to_string(goodput) << "," << to_string(pattern.m_jitter) << "," << to_string(pattern.m_nOutOfOrder) << "," << to_string(pattern.m_nDuplicates) << endl;     
     }
     outdata.close();
+
+    if (m_faceStatistics.size() > 1) {
+      logFaceStatistics();
+    }
+    if (std::count_if(m_sizeStatistics.begin(), m_sizeStatistics.end(),
+                      [] (const auto& stats) { return stats.nResponses > 0; }) > 1) {
+      logSizeStatistics();
+    }
   }
 
   bool
@@ -366,6 +907,81 @@ private:
     return true;
   }
 
+  /**
+   * @brief Generates the ApplicationParameters and signing keys of the patterns that use them.
+   *
+   * Keys live in an in-memory KeyChain, so the run does not depend on, or modify, the user's PIB.
+   */
+  bool
+  prepareInterestSigning()
+  {
+    namespace tr = ndn::security::transform;
+
+    for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
+      auto& pattern = m_trafficPatterns[patternId];
+      if (pattern.m_applicationParametersSize > 0) {
+        pattern.m_applicationParameters.resize(pattern.m_applicationParametersSize);
+        ndn::random::generateSecureBytes(pattern.m_applicationParameters);
+      }
+      if (pattern.m_interestSigning.empty()) {
+        continue;
+      }
+
+      try {
+        if (!m_keyChain) {
+          m_keyChain.emplace("pib-memory:", "tpm-memory:");
+        }
+        if (pattern.m_interestSigning == "DigestSha256") {
+          pattern.m_signingInfo = "id:/localhost/identity/digest-sha256";
+        }
+        else if (pattern.m_interestSigning == "HmacSha256") {
+          std::array<uint8_t, 32> key;
+          ndn::random::generateSecureBytes(key);
+          std::ostringstream os;
+          tr::bufferSource(key) >> tr::base64Encode(false) >> tr::streamSink(os);
+          pattern.m_signingInfo = "hmac-sha256:" + os.str();
+        }
+        else {
+          ndn::Name identityName("/ndn-traffic-client/pattern-" + std::to_string(patternId + 1));
+          auto identity = m_keyChain->createIdentity(identityName, ndn::EcKeyParams());
+          pattern.m_signingInfo = "id:" + identity.getName().toUri();
+        }
+        pattern.m_signer.emplace(*m_keyChain, pattern.m_signingInfo);
+      }
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: cannot prepare signing for Traffic Pattern Type #" +
+                     std::to_string(patternId + 1) + ": " + e.what(), false, true);
+        return false;
+      }
+    }
+
+    if (m_keyChain && m_nSigningThreads > 0) {
+      m_signingPool.emplace(m_nSigningThreads);
+      m_logger.log("Signing Interests on " + std::to_string(m_nSigningThreads) + " threads", true, false);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Returns the signer of @p patternId that belongs to the calling signing pool thread.
+   */
+  FastSigner&
+  getThreadSigner(std::size_t patternId)
+  {
+    // a FastSigner keeps per-call state, so every pool thread builds its own
+    thread_local std::vector<std::optional<FastSigner>> signers;
+    if (signers.size() <= patternId) {
+      signers.resize(m_trafficPatterns.size());
+    }
+    auto& signer = signers[patternId];
+    if (!signer) {
+      // KeyChain::sign() is not thread-safe; once built, a signer only reads the TPM
+      std::lock_guard<std::mutex> lock(m_keyChainMutex);
+      signer.emplace(*m_keyChain, m_trafficPatterns[patternId].m_signingInfo);
+    }
+    return *signer;
+  }
+
   uint32_t
   getNewNonce()
   {
@@ -404,25 +1020,44 @@ private:
     return ndn::name::Component(buf);
   }
 
+  /**
+   * @param[out] variant index of the prototype the Interest is copied from
+   * @param collision outstanding Interest whose name and prototype are reused, instead of new ones
+   */
   auto
-  prepareInterest(std::size_t patternId)
+  prepareInterest(std::size_t patternId, std::size_t& variant,
+                  const std::optional<InFlightName>& collision = std::nullopt)
   {
-    ndn::Interest interest;
     auto& pattern = m_trafficPatterns[patternId];
 
-    ndn::Name name(pattern.m_name);
-    if (pattern.m_nameAppendBytes > 0) {
-      name.append(generateRandomNameComponent(*pattern.m_nameAppendBytes));
+    // one draw picks the combination of attributes; the prototype already carries them
+    variant = 0;
+    if (collision) {
+      // the forwarder only aggregates Interests that also agree on CanBePrefix and MustBeFresh
+      variant = collision->variant;
     }
-    if (pattern.m_nameAppendSeqNum) {
-      auto seqNum = *pattern.m_nameAppendSeqNum;
-      name.appendSequenceNumber(seqNum);
-      pattern.m_nameAppendSeqNum = seqNum + 1;
+    else if (pattern.m_variants.size() > 1) {
+      std::uniform_real_distribution<double> variantDist(0.0, pattern.m_variantTotalWeight);
+      variant = std::min(pattern.m_variantSelector.select(variantDist(ndn::random::getRandomNumberEngine())),
+                         pattern.m_variants.size() - 1);
     }
-    interest.setName(name);
+    ndn::Interest interest(pattern.m_variants[variant]);
 
-    interest.setCanBePrefix(pattern.m_canBePrefix);
-    interest.setMustBeFresh(pattern.m_mustBeFresh);
+    if (collision) {
+      interest.setName(collision->name);
+    }
+    else {
+      ndn::Name name(pattern.m_name);
+      if (pattern.m_nameAppendBytes > 0) {
+        name.append(generateRandomNameComponent(*pattern.m_nameAppendBytes));
+      }
+      if (pattern.m_nameAppendSeqNum) {
+        auto seqNum = *pattern.m_nameAppendSeqNum;
+        name.appendSequenceNumber(seqNum);
+        pattern.m_nameAppendSeqNum = seqNum + 1;
+      }
+      interest.setName(name);
+    }
 
     static std::uniform_int_distribution<unsigned> duplicateNonceDist(1, 100);
     if (duplicateNonceDist(ndn::random::getRandomNumberEngine()) <= pattern.m_nonceDuplicationPercentage)
@@ -430,18 +1065,108 @@ private:
     else
       interest.setNonce(getNewNonce());
 
-    if (pattern.m_interestLifetime >= 0_ms)
-      interest.setInterestLifetime(pattern.m_interestLifetime);
+    return interest;
+  }
 
-    if (pattern.m_nextHopFaceId > 0)
-      interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(pattern.m_nextHopFaceId));
+  /**
+   * @brief Builds the prototype Interests of every pattern, one per combination of the attribute
+   *        mixes that has a non-zero weight, and the table used to draw them.
+   */
+  void
+  buildInterestVariants()
+  {
+    for (auto& pattern : m_trafficPatterns) {
+      ndn::Interest base;
+      if (pattern.m_nextHopFaceId > 0)
+        base.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(pattern.m_nextHopFaceId));
+      if (!pattern.m_applicationParameters.empty())
+        base.setApplicationParameters(pattern.m_applicationParameters);
+
+      // an empty mix leaves the attribute unset
+      const ValueMix unset{WeightedValue{}};
+      const auto& lifetimes = pattern.m_interestLifetimes.empty() ? unset : pattern.m_interestLifetimes;
+      const auto& hopLimits = pattern.m_hopLimits.empty() ? unset : pattern.m_hopLimits;
+      double canBePrefix = pattern.m_canBePrefixPercentage / 100.0;
+      double mustBeFresh = pattern.m_mustBeFreshPercentage / 100.0;
+
+      pattern.m_variants.clear();
+      std::vector<double> weights;
+      for (const auto& lifetime : lifetimes) {
+        for (const auto& hopLimit : hopLimits) {
+          for (bool cbp : {false, true}) {
+            for (bool mbf : {false, true}) {
+              double weight = lifetime.weight * hopLimit.weight * (cbp ? canBePrefix : 1.0 - canBePrefix) *
+                              (mbf ? mustBeFresh : 1.0 - mustBeFresh);
+              if (!(weight > 0.0)) {
+                continue;
+              }
+              ndn::Interest variant(base);
+              variant.setCanBePrefix(cbp);
+              variant.setMustBeFresh(mbf);
+              if (!pattern.m_interestLifetimes.empty())
+                variant.setInterestLifetime(time::milliseconds(lifetime.value));
+              if (!pattern.m_hopLimits.empty())
+                variant.setHopLimit(static_cast<uint8_t>(hopLimit.value));
+              pattern.m_variants.push_back(std::move(variant));
+              weights.push_back(weight);
+            }
+          }
+        }
+      }
+      if (pattern.m_variants.empty()) {
+        // all weights are zero
+        pattern.m_variants.push_back(base);
+        weights.push_back(1.0);
+      }
+      pattern.m_variantSelector.build(weights);
+      pattern.m_variantTotalWeight = std::accumulate(weights.begin(), weights.end(), 0.0);
+    }
+  }
 
-    return interest;
+  /**
+   * @brief Updates the jitter and delivery order of @p patternId with one Data, in constant time.
+   * @param key position in send order: the sequence number of the Data name if the pattern appends
+   *            one, so that copies of the same segment are detected, otherwise the LocalID
+   * @return whether the Data is a duplicate delivery
+   */
+  bool
+  recordDelivery(std::size_t patternId, uint64_t key, const time::steady_clock::time_point& sentTime,
+                 const time::steady_clock::time_point& receiveTime)
+  {
+    auto& pattern = m_trafficPatterns[patternId];
+
+    if (!pattern.m_highestDeliveryKey || key > *pattern.m_highestDeliveryKey) {
+      auto shift = pattern.m_highestDeliveryKey ? key - *pattern.m_highestDeliveryKey : 64;
+      pattern.m_deliveryWindow = (shift >= 64 ? 0 : pattern.m_deliveryWindow << shift) | 1;
+      pattern.m_highestDeliveryKey = key;
+    }
+    else {
+      auto offset = *pattern.m_highestDeliveryKey - key;
+      // keys older than the window can only be counted as out of order
+      if (offset < 64) {
+        if (pattern.m_deliveryWindow & (uint64_t(1) << offset)) {
+          pattern.m_nDuplicates++;
+          return true;
+        }
+        pattern.m_deliveryWindow |= uint64_t(1) << offset;
+      }
+      pattern.m_nOutOfOrder++;
+    }
+
+    // J += (|D| - J) / 16, where D is the difference in transit time with the previous Data
+    if (pattern.m_lastDataSentTime) {
+      auto d = (receiveTime - pattern.m_lastDataReceiveTime) - (sentTime - *pattern.m_lastDataSentTime);
+      double dMs = std::abs(time::duration_cast<time::nanoseconds>(d).count() / 1e6);
+      pattern.m_jitter += (dMs - pattern.m_jitter) / 16;
+    }
+    pattern.m_lastDataSentTime = sentTime;
+    pattern.m_lastDataReceiveTime = receiveTime;
+    return false;
   }
 
   void
-  onData(const ndn::Interest&, const ndn::Data& data, int globalRef, int localRef,
-         std::size_t patternId, const time::steady_clock::time_point& sentTime)
+  onData(const ndn::Interest& interest, const ndn::Data& data, int globalRef, int localRef,
+         std::size_t patternId, std::size_t faceId, const time::steady_clock::time_point& sentTime)
   {
     auto now = time::steady_clock::now();
     auto logLine = "Data Received      - PatternType=" + std::to_string(patternId + 1) +
@@ -452,8 +1177,38 @@ private:
     m_nInterestsReceived++;
     m_trafficPatterns[patternId].m_nInterestsReceived++;
 
+    const auto& content = data.getContent();
+    m_trafficPatterns[patternId].m_nDataBytesReceived += data.wireEncode().size();
+    m_trafficPatterns[patternId].m_nContentBytesReceived += content.value_size();
+    m_trafficPatterns[patternId].m_contentSize.record(content.value_size());
+    std::size_t headerSize = 0;
+    if (auto header = ContentHeader::decode(content.value(), content.value_size()); header) {
+      headerSize = ContentHeader::SIZE;
+      m_nContentHeaders++;
+      m_trafficPatterns[patternId].m_nContentHeaders++;
+      // a newer version had replaced this one by the time it was delivered, e.g. from a cache
+      auto receiveTime = time::toUnixTimestamp<time::microseconds>(time::system_clock::now()).count();
+      if (header->validUntil != 0 && uint64_t(receiveTime) > header->validUntil) {
+        m_nStaleVersions++;
+        m_trafficPatterns[patternId].m_nStaleVersions++;
+      }
+      // the Data was already stale when the Interest was sent, so only a cache can have answered it
+      auto sendTime = receiveTime - time::duration_cast<time::microseconds>(now - sentTime).count();
+      auto freshness = time::duration_cast<time::microseconds>(data.getFreshnessPeriod()).count();
+      if (int64_t(header->generationTime) + freshness < sendTime) {
+        m_trafficPatterns[patternId].m_nStaleResponses++;
+        if (interest.getMustBeFresh()) {
+          m_trafficPatterns[patternId].m_nFreshnessViolations++;
+        }
+      }
+      else {
+        m_trafficPatterns[patternId].m_nFreshResponses++;
+      }
+    }
+
     if (m_trafficPatterns[patternId].m_expectedContent) {
-      std::string receivedContent = readString(data.getContent());
+      std::string receivedContent(reinterpret_cast<const char*>(content.value()) + headerSize,
+                                  content.value_size() - headerSize);
       if (receivedContent != *m_trafficPatterns[patternId].m_expectedContent) {
         m_nContentInconsistencies++;
         m_trafficPatterns[patternId].m_nContentInconsistencies++;
@@ -470,10 +1225,19 @@ private:
       m_logger.log(logLine, true, false);
     }
 
+    uint64_t deliveryKey = localRef;
+    if (m_trafficPatterns[patternId].m_nameAppendSeqNum && !data.getName().empty() &&
+        data.getName()[-1].isSequenceNumber()) {
+      deliveryKey = data.getName()[-1].toSequenceNumber();
+    }
+    bool isDuplicate = recordDelivery(patternId, deliveryKey, sentTime, now);
+
     double rtt = time::duration_cast<time::nanoseconds>(now - sentTime).count() / 1e6;
     if (m_wantVerbose) {
       auto rttLine = "RTT                - Name=" + data.getName().toUri() +
-                     ", RTT=" + std::to_string(rtt) + "ms";
+                     ", RTT=" + std::to_string(rtt) + "ms" +
+                     ", Jitter=" + std::to_string(m_trafficPatterns[patternId].m_jitter) + "ms" +
+                     (isDuplicate ? ", Duplicate=Yes" : "");
       m_logger.log(rttLine, true, false);
     }
     if (m_minimumInterestRoundTripTime > rtt)
@@ -486,15 +1250,96 @@ private:
       m_trafficPatterns[patternId].m_maximumInterestRoundTripTime = rtt;
     m_totalInterestRoundTripTime += rtt;
     m_trafficPatterns[patternId].m_totalInterestRoundTripTime += rtt;
+    m_faceStatistics[faceId].nResponses++;
+    m_faceStatistics[faceId].rtt.record(rtt);
+    auto& sizeStats = m_sizeStatistics[getSizeBucket(content.value_size())];
+    sizeStats.nResponses++;
+    sizeStats.nContentBytes += content.value_size();
+    sizeStats.rtt.record(rtt);
+
+    static std::uniform_real_distribution<double> validationDist(0.0, 100.0);
+    if (!m_verifiers.empty() && validationDist(ndn::random::getRandomNumberEngine()) < m_validationPercentage) {
+      validateData(data, patternId, sentTime);
+    }
 
     if (m_nMaximumInterests == globalRef) {
+      stopAfterValidations();
+    }
+  }
+
+  /**
+   * @brief Validates @p data against the trust policy on the next verifier thread, retrieving
+   *        certificates if needed; the result is handled back on the event loop thread.
+   */
+  void
+  validateData(const ndn::Data& data, std::size_t patternId, const time::steady_clock::time_point& sentTime)
+  {
+    auto receiveTime = time::steady_clock::now();
+    m_nPendingValidations++;
+
+    auto& verifier = *m_verifiers[m_nextVerifierId];
+    m_nextVerifierId = (m_nextVerifierId + 1) % m_verifiers.size();
+    boost::asio::post(verifier.io, [=, &verifier] {
+      verifier.validator.validate(data,
+        [=] (const ndn::Data& validated) {
+          boost::asio::post(m_io, [=] { onValidated(validated, patternId, sentTime, receiveTime, ""); });
+        },
+        [=] (const ndn::Data& failed, const ndn::security::ValidationError& error) {
+          boost::asio::post(m_io, [=, reason = boost::lexical_cast<std::string>(error)] {
+            onValidated(failed, patternId, sentTime, receiveTime, reason);
+          });
+        });
+    });
+  }
+
+  /**
+   * @param error reason why validation failed, or empty if @p data is valid
+   */
+  void
+  onValidated(const ndn::Data& data, std::size_t patternId, const time::steady_clock::time_point& sentTime,
+              const time::steady_clock::time_point& receiveTime, const std::string& error)
+  {
+    auto now = time::steady_clock::now();
+    auto& pattern = m_trafficPatterns[patternId];
+    double validationTime = time::duration_cast<time::nanoseconds>(now - receiveTime).count() / 1e6;
+    pattern.m_validationTime.record(validationTime);
+    pattern.m_validatedResponseTime.record(time::duration_cast<time::nanoseconds>(now - sentTime).count() / 1e6);
+
+    if (error.empty()) {
+      pattern.m_nValidated++;
+      if (m_wantVerbose) {
+        m_logger.log("Data Validated     - Name=" + data.getName().toUri() +
+                     ", ValidationTime=" + std::to_string(validationTime) + "ms", true, false);
+      }
+    }
+    else {
+      pattern.m_nValidationFailures++;
+      m_logger.log("Data Invalid       - PatternType=" + std::to_string(patternId + 1) +
+                   ", Name=" + data.getName().toUri() + ", Reason=" + error, true, false);
+    }
+
+    if (--m_nPendingValidations == 0 && m_wantStop) {
+      stop();
+    }
+  }
+
+  /**
+   * @brief Stops once the validations still in progress have completed.
+   */
+  void
+  stopAfterValidations()
+  {
+    if (m_nPendingValidations > 0) {
+      m_wantStop = true;
+    }
+    else {
       stop();
     }
   }
 
   void
   onNack(const ndn::Interest& interest, const ndn::lp::Nack& nack,
-         int globalRef, int localRef, std::size_t patternId)
+         int globalRef, int localRef, std::size_t patternId, std::size_t faceId)
   {
     auto logLine = "Interest Nack'd    - PatternType=" + std::to_string(patternId + 1) +
                    ", GlobalID=" + std::to_string(globalRef) +
@@ -505,14 +1350,16 @@ private:
 
     m_nNacks++;
     m_trafficPatterns[patternId].m_nNacks++;
+    m_faceStatistics[faceId].nNacks++;
 
     if (m_nMaximumInterests == globalRef) {
-      stop();
+      stopAfterValidations();
     }
   }
 
   void
-  onTimeout(const ndn::Interest& interest, int globalRef, int localRef, std::size_t patternId)
+  onTimeout(const ndn::Interest& interest, int globalRef, int localRef,
+            std::size_t patternId, std::size_t faceId)
   {
     auto logLine = "Interest Timed Out - PatternType=" + std::to_string(patternId + 1) +
                    ", GlobalID=" + std::to_string(globalRef) +
@@ -520,11 +1367,286 @@ private:
                    ", Name=" + interest.getName().toUri();
     m_logger.log(logLine, true, false);
 
+    m_faceStatistics[faceId].nTimeouts++;
+
     if (m_nMaximumInterests == globalRef) {
-      stop();
+      stopAfterValidations();
+    }
+  }
+
+  std::size_t
+  selectFace(const ndn::Interest& interest)
+  {
+    if (m_faces.size() == 1) {
+      return 0;
+    }
+    if (m_faceDispatch == FaceDispatch::NAME_HASH) {
+      // the same name always goes to the same forwarder, preserving cache locality
+      const auto& wire = interest.getName().wireEncode();
+      return hashBytes({reinterpret_cast<const char*>(wire.data()), wire.size()}) % m_faces.size();
+    }
+    return m_nextFaceId++ % m_faces.size();
+  }
+
+  /**
+   * @brief Returns a random Interest among the last NameCollisionWindow ones, if still outstanding.
+   */
+  std::optional<InFlightName>
+  selectCollidingName(InterestTrafficConfiguration& pattern)
+  {
+    if (pattern.m_inFlightNames.empty()) {
+      return std::nullopt;
+    }
+    std::uniform_int_distribution<std::size_t> slotDist(0, pattern.m_inFlightNames.size() - 1);
+    const auto& entry = pattern.m_inFlightNames[slotDist(ndn::random::getRandomNumberEngine())];
+    if (entry.localRef == 0) {
+      return std::nullopt;
+    }
+    return entry;
+  }
+
+  void
+  releaseInFlightName(std::size_t patternId, int localRef)
+  {
+    auto& ring = m_trafficPatterns[patternId].m_inFlightNames;
+    if (!ring.empty()) {
+      auto& entry = ring[localRef % ring.size()];
+      // the slot may have been taken over by a later Interest
+      if (entry.localRef == localRef) {
+        entry.localRef = 0;
+      }
+    }
+  }
+
+  void
+  expressInterest(const ndn::Interest& interest, std::size_t patternId, std::size_t variant,
+                  int globalRef, int localRef, bool isCollision = false)
+  {
+    auto& pattern = m_trafficPatterns[patternId];
+    if (pattern.m_nameCollisionPercentage > 0) {
+      if (pattern.m_inFlightNames.empty()) {
+        pattern.m_inFlightNames.resize(pattern.m_nameCollisionWindow);
+      }
+      pattern.m_inFlightNames[localRef % pattern.m_inFlightNames.size()] = {interest.getName(), variant, localRef};
+    }
+
+    std::size_t faceId = selectFace(interest);
+    // the face reuses this encoding
+    pattern.m_nInterestBytesSent += interest.wireEncode().size();
+    m_faces[faceId]->expressInterest(interest,
+      [=, now = time::steady_clock::now()] (auto&&... args) {
+        releaseInFlightName(patternId, localRef);
+        if (isCollision) {
+          m_trafficPatterns[patternId].m_nCollisionsSatisfied++;
+        }
+        onData(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId, faceId, now);
+      },
+      [=] (auto&&... args) {
+        releaseInFlightName(patternId, localRef);
+        onNack(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId, faceId);
+      },
+      [=] (auto&&... args) {
+        releaseInFlightName(patternId, localRef);
+        onTimeout(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId, faceId);
+      });
+    m_faceStatistics[faceId].nInterestsSent++;
+
+    if (!m_wantQuiet) {
+      auto logLine = "Sending Interest   - PatternType=" + std::to_string(patternId + 1) +
+                     ", GlobalID=" + std::to_string(globalRef) +
+                     ", LocalID=" + std::to_string(localRef) +
+                     ", Name=" + interest.getName().toUri();
+      m_logger.log(logLine, true, false);
     }
   }
 
+  /**
+   * @brief Signs @p interest on the signing pool, then expresses it from the event loop thread.
+   *
+   * Interests may leave in a different order than they were generated, as with any reordering
+   * by the network.
+   */
+  void
+  signInBackground(ndn::Interest interest, std::size_t patternId, std::size_t variant,
+                   int globalRef, int localRef)
+  {
+    boost::asio::post(*m_signingPool, [=, interest = std::move(interest)] () mutable {
+      std::string error;
+      auto start = std::chrono::steady_clock::now();
+      try {
+        getThreadSigner(patternId).sign(interest);
+      }
+      catch (const std::exception& e) {
+        error = e.what();
+      }
+      double signingTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+      boost::asio::post(m_io, [=, interest = std::move(interest), error = std::move(error)] {
+        // the Interest was counted as sent, so the run cannot succeed, and it must still end
+        // if no response will ever come for the last Interest
+        auto onFailure = [&] (const std::string& reason) {
+          m_logger.log("ERROR: cannot send Interest - PatternType=" + std::to_string(patternId + 1) +
+                       ", GlobalID=" + std::to_string(globalRef) + ", Reason=" + reason, true, true);
+          m_hasError = true;
+          if (m_nMaximumInterests == globalRef) {
+            stopAfterValidations();
+          }
+        };
+        if (!error.empty()) {
+          onFailure(error);
+          return;
+        }
+        try {
+          m_trafficPatterns[patternId].m_signingTime.record(signingTime);
+          expressInterest(interest, patternId, variant, globalRef, localRef);
+        }
+        catch (const std::exception& e) {
+          onFailure(e.what());
+        }
+      });
+    });
+  }
+
+  /**
+   * @brief Requests each preloaded item once, then calls @p onComplete.
+   *
+   * Items are the patterns in decreasing popularity: rank order with Zipf-Mandelbrot selection,
+   * TrafficPercentage otherwise. Patterns with NameAppendBytes are skipped, since the workload
+   * never requests the same name twice. Preload Interests only update the preload counters.
+   */
+  void
+  startPreload(std::function<void()> onComplete)
+  {
+    m_preloadQueue.resize(m_trafficPatterns.size());
+    std::iota(m_preloadQueue.begin(), m_preloadQueue.end(), 0);
+    if (mode != 2) {
+      std::stable_sort(m_preloadQueue.begin(), m_preloadQueue.end(), [this] (std::size_t a, std::size_t b) {
+        return m_trafficPatterns[a].m_trafficPercentage > m_trafficPatterns[b].m_trafficPercentage;
+      });
+    }
+    if (m_nPreloadItems > 0 && m_nPreloadItems < m_preloadQueue.size()) {
+      m_preloadQueue.resize(m_nPreloadItems);
+    }
+    auto nItems = m_preloadQueue.size();
+    m_preloadQueue.erase(std::remove_if(m_preloadQueue.begin(), m_preloadQueue.end(), [this] (std::size_t id) {
+      return m_trafficPatterns[id].m_nameAppendBytes > 0;
+    }), m_preloadQueue.end());
+    if (m_preloadQueue.size() < nItems) {
+      m_logger.log("Not preloading " + std::to_string(nItems - m_preloadQueue.size()) +
+                   " items with NameAppendBytes, as their names are random", true, true);
+    }
+
+    m_onPreloadComplete = std::move(onComplete);
+    m_preloadStartTime = time::steady_clock::now();
+    m_logger.log("Preloading " + std::to_string(m_preloadQueue.size()) + " items", true, true);
+    if (m_preloadQueue.empty()) {
+      finishPreload();
+    }
+    else if (m_preloadRate > 0.0) {
+      m_preloadTimer.expires_after(std::chrono::nanoseconds(0));
+      m_preloadTimer.async_wait([this] (const boost::system::error_code& ec) { onPreloadTimer(ec); });
+    }
+    else {
+      fillPreloadWindow();
+    }
+  }
+
+  void
+  onPreloadTimer(const boost::system::error_code& ec)
+  {
+    if (ec || m_nextPreloadItem >= m_preloadQueue.size()) {
+      return;
+    }
+    // a tick is skipped while the window is full, which also caps the rate
+    if (m_nPreloadOutstanding < m_preloadWindow) {
+      sendPreloadInterest();
+    }
+    m_preloadTimer.expires_at(m_preloadTimer.expiry() +
+                              std::chrono::nanoseconds(static_cast<int64_t>(1e9 / m_preloadRate)));
+    m_preloadTimer.async_wait([this] (const boost::system::error_code& ec) { onPreloadTimer(ec); });
+  }
+
+  void
+  fillPreloadWindow()
+  {
+    while (m_nPreloadOutstanding < m_preloadWindow && m_nextPreloadItem < m_preloadQueue.size()) {
+      sendPreloadInterest();
+    }
+  }
+
+  void
+  sendPreloadInterest()
+  {
+    auto& pattern = m_trafficPatterns[m_preloadQueue[m_nextPreloadItem++]];
+
+    // the pattern name, or the next sequence number under it, which is not consumed
+    ndn::Interest interest(pattern.m_variants.front());
+    ndn::Name name(pattern.m_name);
+    if (pattern.m_nameAppendSeqNum) {
+      name.appendSequenceNumber(*pattern.m_nameAppendSeqNum);
+    }
+    interest.setName(name);
+    interest.setNonce(getNewNonce());
+    if (pattern.m_signer) {
+      // a server validating Interests would drop an unsigned one
+      try {
+        pattern.m_signer->sign(interest);
+      }
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: cannot sign preload Interest - Name=" + name.toUri() + ", Reason=" + e.what(),
+                     true, true);
+        m_nPreloadOutstanding++;
+        onPreloadResponse(false);
+        return;
+      }
+    }
+
+    m_nPreloadOutstanding++;
+    m_faces[selectFace(interest)]->expressInterest(interest,
+      [this] (const auto&, const auto& data) {
+        m_nPreloadBytes += data.wireEncode().size();
+        onPreloadResponse(true);
+      },
+      [this] (auto&&...) { onPreloadResponse(false); },
+      [this] (auto&&...) { onPreloadResponse(false); });
+  }
+
+  void
+  onPreloadResponse(bool isSatisfied)
+  {
+    m_nPreloadOutstanding--;
+    (isSatisfied ? m_nPreloadSatisfied : m_nPreloadFailed)++;
+
+    std::size_t nDone = m_nPreloadSatisfied + m_nPreloadFailed;
+    // progress is logged every 10%
+    if (nDone * 10 / m_preloadQueue.size() != (nDone - 1) * 10 / m_preloadQueue.size()) {
+      m_logger.log("Preload progress: " + std::to_string(nDone) + "/" + std::to_string(m_preloadQueue.size()),
+                   true, false);
+    }
+
+    if (nDone == m_preloadQueue.size()) {
+      finishPreload();
+    }
+    else if (m_preloadRate <= 0.0) {
+      fillPreloadWindow();
+    }
+  }
+
+  void
+  finishPreload()
+  {
+    using std::to_string;
+
+    m_preloadTimer.cancel();
+    double elapsed = time::duration_cast<time::nanoseconds>(time::steady_clock::now() - m_preloadStartTime).count() / 1e9;
+    double rate = elapsed > 0.0 ? m_preloadQueue.size() / elapsed : 0.0;
+    m_logger.log("Preload completed: " + to_string(m_nPreloadSatisfied) + " satisfied, " +
+                 to_string(m_nPreloadFailed) + " failed in " + to_string(elapsed) + "s (" +
+                 to_string(rate) + " Interests/s, " + to_string(getMbitPerSecond(m_nPreloadBytes, elapsed)) +
+                 "Mbit/s); starting the measured workload", true, true);
+    m_onPreloadComplete();
+  }
+
   void
   generateTraffic(boost::asio::steady_timer& timer)
   {
@@ -540,53 +1662,54 @@ private:
     }
 
     if (mode == 2){
-      static rng::zipf_mandelbrot_distribution<rng::discrete_distribution_30bit,int> trafficDistZipf(zipffactor, qvalue, nprefix);
-      trafficKey = trafficDistZipf(ndn::random::getRandomNumberEngine());
+      trafficKey = (*m_zipfDistribution)(ndn::random::getRandomNumberEngine());
       trafficKey -= qvalue;
     }
 
-    double cumulativePercentage = 0.0;
-    std::size_t patternId = 0;
-    for (; patternId < m_trafficPatterns.size(); patternId++) {
+    std::size_t patternId = m_patternSelector.select(trafficKey);
+    if (patternId < m_trafficPatterns.size()) {
       auto& pattern = m_trafficPatterns[patternId];
-      cumulativePercentage += pattern.m_trafficPercentage;
-      if (trafficKey <= cumulativePercentage) {
-        m_nInterestsSent++;
-        pattern.m_nInterestsSent++;
-        auto interest = prepareInterest(patternId);
-        try {
-          int globalRef = m_nInterestsSent;
-          int localRef = pattern.m_nInterestsSent;
-          m_face.expressInterest(interest,
-            [=, now = time::steady_clock::now()] (auto&&... args) {
-              onData(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId, now);
-            },
-            [=] (auto&&... args) {
-              onNack(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId);
-            },
-            [=] (auto&&... args) {
-              onTimeout(std::forward<decltype(args)>(args)..., globalRef, localRef, patternId);
-            });
-
-          if (!m_wantQuiet) {
-            auto logLine = "Sending Interest   - PatternType=" + std::to_string(patternId + 1) +
-                           ", GlobalID=" + std::to_string(m_nInterestsSent) +
-                           ", LocalID=" + std::to_string(pattern.m_nInterestsSent) +
-                           ", Name=" + interest.getName().toUri();
-            m_logger.log(logLine, true, false);
-          }
-
-          timer.expires_at(timer.expiry() + m_interestInterval);
-          timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
+      m_nInterestsSent++;
+      pattern.m_nInterestsSent++;
+      // signed Interests never collide, as the signature changes their ParametersSha256Digest
+      std::optional<InFlightName> collision;
+      static std::uniform_int_distribution<unsigned> collisionDist(1, 100);
+      if (pattern.m_nameCollisionPercentage > 0 && !pattern.m_signer &&
+          collisionDist(ndn::random::getRandomNumberEngine()) <= pattern.m_nameCollisionPercentage) {
+        collision = selectCollidingName(pattern);
+        if (collision) {
+          pattern.m_nCollisions++;
         }
-        catch (const std::exception& e) {
-          m_logger.log("ERROR: "s + e.what(), true, true);
+        else {
+          pattern.m_nCollisionMisses++;
         }
-        break;
       }
-    }
+      std::size_t variant = 0;
+      auto interest = prepareInterest(patternId, variant, collision);
+      try {
+        int globalRef = m_nInterestsSent;
+        int localRef = pattern.m_nInterestsSent;
+        if (pattern.m_signer && m_signingPool) {
+          signInBackground(std::move(interest), patternId, variant, globalRef, localRef);
+        }
+        else {
+          if (pattern.m_signer) {
+            auto start = std::chrono::steady_clock::now();
+            pattern.m_signer->sign(interest);
+            pattern.m_signingTime.record(std::chrono::duration<double, std::micro>(
+                                           std::chrono::steady_clock::now() - start).count());
+          }
+          expressInterest(interest, patternId, variant, globalRef, localRef, collision.has_value());
+        }
 
-    if (patternId == m_trafficPatterns.size()) {
+        timer.expires_at(timer.expiry() + m_interestInterval);
+        timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
+      }
+      catch (const std::exception& e) {
+        m_logger.log("ERROR: "s + e.what(), true, true);
+      }
+    }
+    else {
       timer.expires_at(timer.expiry() + m_interestInterval);
       timer.async_wait([this, &timer] (auto&&...) { generateTraffic(timer); });
     }
@@ -599,28 +1722,71 @@ private:
       m_hasError = true;
     }
 
+    if (m_signingPool) {
+      // Interests still waiting to be signed are not sent
+      m_signingPool->stop();
+    }
+
+    // Data still being validated is not counted
+    stopVerifiers();
+
     logStatistics();
-    m_face.shutdown();
+    for (auto& face : m_faces) {
+      face->shutdown();
+    }
     m_io.stop();
   }
 
+  /**
+   * @brief Shuts down the faces of all verifier threads and waits for them to exit.
+   */
+  void
+  stopVerifiers()
+  {
+    for (const auto& verifierPtr : m_verifiers) {
+      auto& verifier = *verifierPtr;
+      if (!verifier.thread.joinable()) {
+        continue;
+      }
+      boost::asio::post(verifier.io, [&verifier] {
+        verifier.face.shutdown();
+        verifier.io.stop();
+      });
+      verifier.thread.join();
+    }
+  }
+
 private:
   Logger m_logger{"NdnTrafficClient"};
   boost::asio::io_context m_io;
   boost::asio::signal_set m_signalSet{m_io, SIGINT, SIGTERM};
-  ndn::Face m_face{m_io};
+  std::vector<std::unique_ptr<ndn::Face>> m_faces;
+  BatchingOptions m_batchingOptions;
+  std::vector<std::shared_ptr<BatchingTransport>> m_batchingTransports;
+  std::vector<std::string> m_faceUris;
+  FaceDispatch m_faceDispatch = FaceDispatch::ROUND_ROBIN;
+  std::vector<FaceStatistics> m_faceStatistics;
+  std::array<SizeStatistics, N_SIZE_BUCKETS> m_sizeStatistics;
+  time::steady_clock::time_point m_startTime;
+  std::size_t m_nextFaceId = 0;
 
   std::string m_configurationFile;
   std::string m_timestampFormat;
   std::optional<uint64_t> m_nMaximumInterests;
   std::chrono::milliseconds m_interestInterval{1s};
+  std::string m_samplerCacheDirectory;
+  unsigned m_nSamplerThreads = 1;
+  std::unique_ptr<SamplerCache::ZipfDistribution> m_zipfDistribution;
 
   std::vector<InterestTrafficConfiguration> m_trafficPatterns;
+  PatternSelector m_patternSelector;
   std::vector<uint32_t> m_nonces;
   uint64_t m_nInterestsSent = 0;
   uint64_t m_nInterestsReceived = 0;
   uint64_t m_nNacks = 0;
   uint64_t m_nContentInconsistencies = 0;
+  uint64_t m_nContentHeaders = 0;
+  uint64_t m_nStaleVersions = 0;
 
   // RTT is stored as milliseconds with fractional sub-milliseconds precision
   double m_minimumInterestRoundTripTime = std::numeric_limits<double>::max();
@@ -630,6 +1796,35 @@ private:
   bool m_wantQuiet = false;
   bool m_wantVerbose = false;
   bool m_hasError = false;
+
+  std::optional<ndn::KeyChain> m_keyChain; // only created if a pattern signs its Interests
+  std::mutex m_keyChainMutex;
+  unsigned m_nSigningThreads = 0;
+
+  std::string m_validatorConfigFile; // empty disables Data validation
+  double m_validationPercentage = 100.0;
+  unsigned m_nVerifiers = 1;
+  std::size_t m_nextVerifierId = 0;
+  uint64_t m_nPendingValidations = 0;
+  bool m_wantStop = false;
+
+  bool m_wantPreload = false;
+  std::size_t m_nPreloadItems = 0;
+  std::size_t m_preloadWindow = 64;
+  double m_preloadRate = 0.0;
+  boost::asio::steady_timer m_preloadTimer{m_io};
+  std::vector<std::size_t> m_preloadQueue; // pattern IDs in decreasing popularity
+  std::size_t m_nextPreloadItem = 0;
+  std::size_t m_nPreloadOutstanding = 0;
+  uint64_t m_nPreloadSatisfied = 0;
+  uint64_t m_nPreloadFailed = 0;
+  uint64_t m_nPreloadBytes = 0;
+  time::steady_clock::time_point m_preloadStartTime;
+  std::function<void()> m_onPreloadComplete;
+
+  // declared last, so that their threads are joined before anything they use is destroyed
+  std::vector<std::unique_ptr<Verifier>> m_verifiers;
+  std::optional<boost::asio::thread_pool> m_signingPool;
 };
 
 } // namespace ndntg
@@ -671,6 +1866,35 @@ main(int argc, char* argv[])
     ("mode,m",      po::value<int>(), "(int) Distribution choice : 1. Uniform, 2. Zipf-Mandelbrot; Default = Uniform")
     ("zipffactor,z",po::value<float>(), "(float) Used in Zipf-Mandelbrot as s value, default = 0.5")
     ("qvalue,v",   po::value<float>(), "(float) Used in Zipf-Mandelbrot as q value, default = 0")
+    ("face-uri,f",  po::value<std::vector<std::string>>()->composing(),
+                    "forwarder to connect to, e.g. unix:///run/nfd/nfd.sock or tcp4://127.0.0.1:6363; "
+                    "repeat to spread Interests over several forwarders")
+    ("face-dispatch", po::value<std::string>()->default_value("rr"),
+                    "how Interests are spread over several forwarders: 'rr' (round-robin) or 'hash' (by name)")
+    ("batch-bytes", po::value<std::size_t>()->default_value(0),
+                    "coalesce outgoing packets into one socket write of up to this many bytes (0 = off)")
+    ("batch-delay", po::value<int64_t>()->default_value(0),
+                    "with --batch-bytes, delay in microseconds before a partial batch is written "
+                    "(0 = end of the event loop iteration)")
+    ("sampler-cache", po::value<std::string>(),
+                    "directory where Zipf-Mandelbrot sampler tables are cached across runs")
+    ("sampler-threads", po::value<unsigned>()->default_value(std::max(std::thread::hardware_concurrency(), 1U)),
+                    "number of threads used to build the sampler tables on a cache miss")
+    ("signing-threads", po::value<unsigned>()->default_value(0),
+                    "sign Interests of patterns with InterestSigning on this many threads "
+                    "(0 = on the event loop thread)")
+    ("validator-config", po::value<std::string>(),
+                    "validate received Data against the trust policy in this ndn-cxx validator configuration file")
+    ("validation-percentage", po::value<double>()->default_value(100.0),
+                    "with --validator-config, percentage of received Data that is validated")
+    ("validation-threads", po::value<unsigned>()->default_value(1),
+                    "with --validator-config, number of threads validating Data, each with its own face and validator")
+    ("preload", po::value<std::size_t>(),
+                    "before the measured workload, request the N most popular patterns once (0 = all)")
+    ("preload-window", po::value<std::size_t>()->default_value(64),
+                    "with --preload, maximum number of outstanding preload Interests")
+    ("preload-rate", po::value<double>()->default_value(0),
+                    "with --preload, maximum preload Interests per second (0 = limited by the window only)")
     ;
 
   po::options_description hiddenOptions;
@@ -762,5 +1986,52 @@ main(int argc, char* argv[])
     client.setVerboseLogging();
   }
 
+  if (vm.count("face-uri") > 0) {
+    auto dispatch = vm["face-dispatch"].as<std::string>();
+    if (dispatch != "rr" && dispatch != "hash") {
+      std::cerr << "ERROR: the argument for option '--face-dispatch' must be 'rr' or 'hash'\n";
+      return 2;
+    }
+    client.setFaceUris(vm["face-uri"].as<std::vector<std::string>>(),
+                       dispatch == "hash" ? ndntg::NdnTrafficClient::FaceDispatch::NAME_HASH
+                                          : ndntg::NdnTrafficClient::FaceDispatch::ROUND_ROBIN);
+  }
+
+  if (vm["batch-delay"].as<int64_t>() < 0) {
+    std::cerr << "ERROR: the argument for option '--batch-delay' cannot be negative\n";
+    return 2;
+  }
+  ndntg::BatchingOptions batching;
+  batching.maxBytes = vm["batch-bytes"].as<std::size_t>();
+  batching.maxDelay = std::chrono::microseconds(vm["batch-delay"].as<int64_t>());
+  client.setBatching(batching);
+
+  client.setSamplerCache(vm.count("sampler-cache") > 0 ? vm["sampler-cache"].as<std::string>() : "",
+                         vm["sampler-threads"].as<unsigned>());
+  client.setSigningThreads(vm["signing-threads"].as<unsigned>());
+
+  if (vm.count("preload") > 0) {
+    if (vm["preload-window"].as<std::size_t>() == 0 || !(vm["preload-rate"].as<double>() >= 0.0)) {
+      std::cerr << "ERROR: '--preload-window' must be positive and '--preload-rate' cannot be negative\n";
+      return 2;
+    }
+    client.setPreload(vm["preload"].as<std::size_t>(), vm["preload-window"].as<std::size_t>(),
+                      vm["preload-rate"].as<double>());
+  }
+
+  if (vm.count("validator-config") > 0) {
+    auto percentage = vm["validation-percentage"].as<double>();
+    if (!(percentage >= 0.0 && percentage <= 100.0)) {
+      std::cerr << "ERROR: the argument for option '--validation-percentage' must be between 0 and 100\n";
+      return 2;
+    }
+    auto nThreads = vm["validation-threads"].as<unsigned>();
+    if (nThreads == 0) {
+      std::cerr << "ERROR: the argument for option '--validation-threads' must be positive\n";
+      return 2;
+    }
+    client.setDataValidation(vm["validator-config"].as<std::string>(), percentage, nThreads);
+  }
+
   return client.run();
 }
@@ -0,0 +1,651 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+namespace ndntg {
+
+/**
+ * @brief Samples collected from all repeated runs of one build.
+ */
+class RunSet
+{
+public:
+  explicit
+  RunSet(std::size_t maxSamples, uint32_t seed)
+    : m_maxSamples(maxSamples)
+    , m_rng(seed)
+  {
+  }
+
+  /**
+   * @brief Loads either a log.csv summary or a per-packet client log.
+   */
+  bool
+  loadFile(const std::string& filename, std::chrono::milliseconds interval)
+  {
+    std::ifstream is(filename);
+    if (!is) {
+      std::cerr << "ERROR: Unable to open file: " << filename << std::endl;
+      return false;
+    }
+
+    std::string firstLine;
+    std::getline(is, firstLine);
+    if (boost::starts_with(firstLine, "PatternID,")) {
+      return loadSummary(is, firstLine, filename);
+    }
+
+    is.seekg(0);
+    loadPacketLog(is, interval);
+    return true;
+  }
+
+  const std::vector<double>&
+  getRunMetric(const std::string& column) const
+  {
+    static const std::vector<double> empty;
+    auto it = m_runMetrics.find(column);
+    return it != m_runMetrics.end() ? it->second : empty;
+  }
+
+  const std::vector<double>&
+  getThroughputSamples() const
+  {
+    return m_throughput;
+  }
+
+  const std::vector<double>&
+  getRttSamples() const
+  {
+    return m_rtt;
+  }
+
+  /**
+   * @brief Returns, for each RTT sample, the interval of its run it was received in.
+   */
+  const std::vector<std::size_t>&
+  getRttIntervals() const
+  {
+    return m_rttInterval;
+  }
+
+private:
+  bool
+  loadSummary(std::istream& is, const std::string& header, const std::string& filename)
+  {
+    auto columns = splitCsv(header);
+    std::string line;
+    while (std::getline(is, line)) {
+      auto fields = splitCsv(line);
+      if (fields.empty() || fields[0] != "Overall") {
+        continue;
+      }
+      for (std::size_t i = 1; i < std::min(fields.size(), columns.size()); i++) {
+        try {
+          m_runMetrics[columns[i]].push_back(std::stod(fields[i]));
+        }
+        catch (const std::exception&) {
+        }
+      }
+      return true;
+    }
+
+    std::cerr << "ERROR: No 'Overall' row in summary file: " << filename << std::endl;
+    return false;
+  }
+
+  void
+  loadPacketLog(std::istream& is, std::chrono::milliseconds interval)
+  {
+    // per-interval Data counts of this run, indexed from the first Data of the run
+    std::vector<uint64_t> bins;
+    std::optional<double> firstTimestamp;
+    double binWidth = interval.count() / 1000.0;
+
+    std::size_t bin = 0;
+    auto getBin = [&] (const std::string& line) {
+      if (auto timestamp = parseTimestamp(line); timestamp) {
+        if (!firstTimestamp) {
+          firstTimestamp = timestamp;
+        }
+        bin = static_cast<std::size_t>(std::max(0.0, (*timestamp - *firstTimestamp) / binWidth));
+      }
+      return bin;
+    };
+
+    std::string line;
+    while (std::getline(is, line)) {
+      if (line.find("Data Received") != std::string::npos) {
+        if (!parseTimestamp(line)) {
+          continue;
+        }
+        getBin(line);
+        if (bin >= bins.size()) {
+          bins.resize(bin + 1, 0);
+        }
+        bins[bin]++;
+      }
+      else if (auto pos = line.find(", RTT="); pos != std::string::npos) {
+        try {
+          double rtt = std::stod(line.substr(pos + 6));
+          // intervals are numbered across runs, so that samples of different runs never share one
+          std::size_t interval = m_nIntervals + getBin(line);
+          if (auto slot = addSample(m_rtt, m_nRttSeen, rtt); slot) {
+            m_rttInterval.resize(m_rtt.size());
+            m_rttInterval[*slot] = interval;
+          }
+        }
+        catch (const std::exception&) {
+        }
+      }
+    }
+    m_nIntervals += std::max(bins.size(), bin + 1);
+
+    // the last bin is usually partial, skip it
+    for (std::size_t i = 0; i + 1 < bins.size(); i++) {
+      m_throughput.push_back(bins[i] / binWidth);
+    }
+  }
+
+  static std::optional<double>
+  parseTimestamp(const std::string& line)
+  {
+    if (line.empty() || line[0] != '[') {
+      return std::nullopt;
+    }
+    try {
+      std::size_t pos = 0;
+      double seconds = std::stod(line.substr(1), &pos);
+      if (line.size() > pos + 1 && line[pos + 1] == ']') {
+        return seconds;
+      }
+    }
+    catch (const std::exception&) {
+    }
+    return std::nullopt;
+  }
+
+  static std::vector<std::string>
+  splitCsv(const std::string& line)
+  {
+    std::vector<std::string> fields;
+    std::istringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+      fields.push_back(field);
+    }
+    return fields;
+  }
+
+  /**
+   * @brief Reservoir sampling, keeps at most m_maxSamples uniformly chosen samples.
+   * @return the index where @p value was stored, or nullopt if it was not kept
+   */
+  std::optional<std::size_t>
+  addSample(std::vector<double>& samples, uint64_t& nSeen, double value)
+  {
+    nSeen++;
+    if (samples.size() < m_maxSamples) {
+      samples.push_back(value);
+      return samples.size() - 1;
+    }
+    std::uniform_int_distribution<uint64_t> dist(0, nSeen - 1);
+    auto slot = dist(m_rng);
+    if (slot < samples.size()) {
+      samples[slot] = value;
+      return slot;
+    }
+    return std::nullopt;
+  }
+
+private:
+  std::size_t m_maxSamples;
+  std::mt19937_64 m_rng;
+  std::map<std::string, std::vector<double>> m_runMetrics;
+  std::vector<double> m_throughput;
+  std::vector<double> m_rtt;
+  std::vector<std::size_t> m_rttInterval; // parallel to m_rtt
+  uint64_t m_nRttSeen = 0;
+  std::size_t m_nIntervals = 0; // over all runs loaded so far
+};
+
+/**
+ * @brief Compares two run sets and flags statistically significant regressions.
+ */
+class NdnTrafficCompare : boost::noncopyable
+{
+public:
+  enum class Direction {
+    HIGHER_IS_BETTER,
+    LOWER_IS_BETTER,
+  };
+
+  /**
+   * @brief Mean, or a percentile, of a sample.
+   */
+  struct Statistic
+  {
+    std::optional<double> percentile;
+
+    double
+    operator()(std::vector<double> v) const
+    {
+      return percentile ? computePercentile(v, *percentile) : computeMean(v);
+    }
+  };
+
+  NdnTrafficCompare(double alpha, std::size_t nResamples, uint32_t seed)
+    : m_alpha(alpha)
+    , m_nResamples(nResamples)
+    , m_rng(seed)
+  {
+  }
+
+  void
+  printHeader(std::ostream& os) const
+  {
+    os << std::left << std::setw(26) << "Metric"
+       << std::right << std::setw(8) << "N(A)" << std::setw(8) << "N(B)"
+       << std::setw(14) << "Baseline" << std::setw(14) << "Candidate"
+       << std::setw(12) << "Delta(%)"
+       << std::setw(28) << ("Delta " + std::to_string(static_cast<int>((1 - m_alpha) * 100)) + "% CI")
+       << std::setw(10) << "p-value" << "  Verdict\n";
+  }
+
+  /**
+   * @brief Compares a statistic of two samples of independent values.
+   * @param percentile percentile to compare, or nullopt to compare means
+   */
+  void
+  compare(std::ostream& os, const std::string& metric, const std::vector<double>& a,
+          const std::vector<double>& b, std::optional<double> percentile, Direction direction)
+  {
+    if (!printSampleSizes(os, metric, a, b)) {
+      return;
+    }
+
+    auto resample = [this] (const std::vector<double>& v) {
+      return [this, &v] (std::vector<double>& out) {
+        std::uniform_int_distribution<std::size_t> dist(0, v.size() - 1);
+        out.resize(v.size());
+        for (auto& x : out) {
+          x = v[dist(m_rng)];
+        }
+      };
+    };
+    Statistic statistic{percentile};
+    auto [lo, hi] = bootstrapDelta(resample(a), resample(b), statistic);
+    printResult(os, statistic(a), statistic(b), lo, hi, mannWhitneyPValue(a, b), direction);
+  }
+
+  /**
+   * @brief Compares a statistic of two samples whose values are correlated within an interval,
+   *        such as the RTTs of the Data received in the same interval of a run.
+   * @param intervalsA interval of each value of @p a
+   * @param intervalsB interval of each value of @p b
+   *
+   * Whole intervals are resampled, and as the values are not independent, no rank test applies:
+   * the verdict only depends on the confidence interval.
+   */
+  void
+  compareByInterval(std::ostream& os, const std::string& metric,
+                    const std::vector<double>& a, const std::vector<std::size_t>& intervalsA,
+                    const std::vector<double>& b, const std::vector<std::size_t>& intervalsB,
+                    std::optional<double> percentile, Direction direction)
+  {
+    if (!printSampleSizes(os, metric, a, b)) {
+      return;
+    }
+
+    auto groupA = groupByInterval(a, intervalsA);
+    auto groupB = groupByInterval(b, intervalsB);
+    auto resample = [this] (const std::vector<std::vector<double>>& groups) {
+      return [this, &groups] (std::vector<double>& out) {
+        std::uniform_int_distribution<std::size_t> dist(0, groups.size() - 1);
+        out.clear();
+        for (std::size_t i = 0; i < groups.size(); i++) {
+          const auto& group = groups[dist(m_rng)];
+          out.insert(out.end(), group.begin(), group.end());
+        }
+      };
+    };
+    Statistic statistic{percentile};
+    auto [lo, hi] = bootstrapDelta(resample(groupA), resample(groupB), statistic);
+    printResult(os, statistic(a), statistic(b), lo, hi, std::nullopt, direction);
+  }
+
+  std::size_t
+  getRegressionCount() const
+  {
+    return m_nRegressions;
+  }
+
+private:
+  static std::vector<std::vector<double>>
+  groupByInterval(const std::vector<double>& values, const std::vector<std::size_t>& intervals)
+  {
+    std::map<std::size_t, std::vector<double>> groups;
+    for (std::size_t i = 0; i < values.size(); i++) {
+      groups[intervals.at(i)].push_back(values[i]);
+    }
+    std::vector<std::vector<double>> result;
+    result.reserve(groups.size());
+    for (auto& group : groups) {
+      result.push_back(std::move(group.second));
+    }
+    return result;
+  }
+
+  /**
+   * @return false if there is nothing to compare
+   */
+  static bool
+  printSampleSizes(std::ostream& os, const std::string& metric, const std::vector<double>& a,
+                   const std::vector<double>& b)
+  {
+    os << std::left << std::setw(26) << metric << std::right
+       << std::setw(8) << a.size() << std::setw(8) << b.size();
+    if (a.empty() || b.empty()) {
+      os << "  (no samples)\n";
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @param pValue p-value of the rank test, or nullopt if the verdict only depends on the CI
+   */
+  void
+  printResult(std::ostream& os, double statA, double statB, double lo, double hi,
+              std::optional<double> pValue, Direction direction)
+  {
+    double delta = statB - statA;
+    std::ostringstream ci;
+    ci << std::setprecision(4) << "[" << lo << ", " << hi << "]";
+    std::ostringstream p;
+    if (pValue) {
+      p << std::setprecision(3) << *pValue;
+    }
+    else {
+      p << "-";
+    }
+
+    os << std::setprecision(6)
+       << std::setw(14) << statA << std::setw(14) << statB
+       << std::setw(12) << std::setprecision(3) << (statA != 0 ? delta * 100.0 / statA : 0.0)
+       << std::setw(28) << ci.str()
+       << std::setw(10) << p.str() << "  ";
+
+    bool isSignificant = (!pValue || *pValue < m_alpha) && (lo > 0 || hi < 0);
+    bool isWorse = direction == Direction::HIGHER_IS_BETTER ? delta < 0 : delta > 0;
+    if (!isSignificant) {
+      os << "no significant change\n";
+    }
+    else if (isWorse) {
+      os << "REGRESSION\n";
+      m_nRegressions++;
+    }
+    else {
+      os << "improvement\n";
+    }
+  }
+
+  static double
+  computeMean(const std::vector<double>& v)
+  {
+    double sum = 0.0;
+    for (double x : v) {
+      sum += x;
+    }
+    return sum / v.size();
+  }
+
+  static double
+  computePercentile(std::vector<double>& v, double p)
+  {
+    auto k = static_cast<std::size_t>(std::ceil(p / 100.0 * v.size()));
+    k = std::clamp<std::size_t>(k, 1, v.size()) - 1;
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+  }
+
+  /**
+   * @brief Percentile bootstrap confidence interval of statistic(B) - statistic(A).
+   * @param resampleA fills its argument with one bootstrap resample of A
+   * @param resampleB fills its argument with one bootstrap resample of B
+   */
+  template<typename ResampleA, typename ResampleB>
+  std::pair<double, double>
+  bootstrapDelta(const ResampleA& resampleA, const ResampleB& resampleB, const Statistic& statistic)
+  {
+    std::vector<double> deltas;
+    deltas.reserve(m_nResamples);
+    std::vector<double> sampleA;
+    std::vector<double> sampleB;
+
+    for (std::size_t i = 0; i < m_nResamples; i++) {
+      resampleA(sampleA);
+      resampleB(sampleB);
+      deltas.push_back(statistic(sampleB) - statistic(sampleA));
+    }
+
+    std::sort(deltas.begin(), deltas.end());
+    auto at = [&deltas] (double q) {
+      auto idx = static_cast<std::size_t>(q * (deltas.size() - 1));
+      return deltas[idx];
+    };
+    return {at(m_alpha / 2), at(1 - m_alpha / 2)};
+  }
+
+  /**
+   * @brief Two-sided Mann-Whitney U test, normal approximation with tie correction.
+   */
+  static double
+  mannWhitneyPValue(const std::vector<double>& a, const std::vector<double>& b)
+  {
+    std::vector<std::pair<double, bool>> pooled;
+    pooled.reserve(a.size() + b.size());
+    for (double x : a) {
+      pooled.emplace_back(x, false);
+    }
+    for (double x : b) {
+      pooled.emplace_back(x, true);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double n1 = a.size();
+    double n2 = b.size();
+    double n = n1 + n2;
+    double rankSumA = 0.0;
+    double tieTerm = 0.0;
+    for (std::size_t i = 0; i < pooled.size();) {
+      std::size_t j = i;
+      while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+        j++;
+      }
+      double avgRank = (i + 1 + j) / 2.0;
+      double t = j - i;
+      tieTerm += t * t * t - t;
+      for (std::size_t k = i; k < j; k++) {
+        if (!pooled[k].second) {
+          rankSumA += avgRank;
+        }
+      }
+      i = j;
+    }
+
+    double u = rankSumA - n1 * (n1 + 1) / 2.0;
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - tieTerm / (n * (n - 1)));
+    if (variance <= 0) {
+      return 1.0;
+    }
+    double z = (std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::min(1.0, std::erfc(std::max(z, 0.0) / std::sqrt(2.0)));
+  }
+
+private:
+  double m_alpha;
+  std::size_t m_nResamples;
+  std::mt19937_64 m_rng;
+  std::size_t m_nRegressions = 0;
+};
+
+} // namespace ndntg
+
+namespace po = boost::program_options;
+
+static void
+usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
+{
+  os << "Usage: " << programName << " [options] -a <File>... -b <File>...\n"
+     << "\n"
+     << "Compare repeated ndn-traffic-client runs of a baseline (A) and a candidate (B).\n"
+     << "Each File is either a log.csv summary or a per-packet client log; per-packet logs\n"
+     << "should be collected with '--verbose' to include RTT samples.\n"
+     << "The exit status is 1 if a significant regression is detected.\n"
+     << "\n"
+     << desc;
+}
+
+int
+main(int argc, char* argv[])
+{
+  using ndntg::NdnTrafficCompare;
+
+  std::vector<std::string> baselineFiles;
+  std::vector<std::string> candidateFiles;
+
+  po::options_description visibleOptions("Options");
+  visibleOptions.add_options()
+    ("help,h",      "print this help message and exit")
+    ("baseline,a",  po::value<std::vector<std::string>>(&baselineFiles)->multitoken(),
+                    "output files of the baseline runs")
+    ("candidate,b", po::value<std::vector<std::string>>(&candidateFiles)->multitoken(),
+                    "output files of the candidate runs")
+    ("interval,i",  po::value<std::chrono::milliseconds::rep>()->default_value(1000),
+                    "throughput sampling interval in milliseconds")
+    ("alpha",       po::value<double>()->default_value(0.05), "significance level")
+    ("resamples,r", po::value<std::size_t>()->default_value(1000), "number of bootstrap resamples")
+    ("max-samples", po::value<std::size_t>()->default_value(20000),
+                    "maximum number of RTT samples kept per build (reservoir sampling)")
+    ("seed",        po::value<uint32_t>()->default_value(1), "random seed for resampling")
+    ;
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(visibleOptions).run(), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+  catch (const boost::bad_any_cast& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    usage(std::cout, argv[0], visibleOptions);
+    return 0;
+  }
+
+  if (baselineFiles.empty() || candidateFiles.empty()) {
+    usage(std::cerr, argv[0], visibleOptions);
+    return 2;
+  }
+
+  auto alpha = vm["alpha"].as<double>();
+  if (!(alpha > 0 && alpha < 1)) {
+    std::cerr << "ERROR: the argument for option '--alpha' must be in (0, 1)\n";
+    return 2;
+  }
+
+  std::chrono::milliseconds interval(vm["interval"].as<std::chrono::milliseconds::rep>());
+  if (interval <= std::chrono::milliseconds::zero()) {
+    std::cerr << "ERROR: the argument for option '--interval' must be positive\n";
+    return 2;
+  }
+
+  auto seed = vm["seed"].as<uint32_t>();
+  auto maxSamples = std::max<std::size_t>(vm["max-samples"].as<std::size_t>(), 1);
+  ndntg::RunSet baseline(maxSamples, seed);
+  ndntg::RunSet candidate(maxSamples, seed + 1);
+  for (const auto& file : baselineFiles) {
+    if (!baseline.loadFile(file, interval))
+      return 2;
+  }
+  for (const auto& file : candidateFiles) {
+    if (!candidate.loadFile(file, interval))
+      return 2;
+  }
+
+  NdnTrafficCompare cmp(alpha, std::max<std::size_t>(vm["resamples"].as<std::size_t>(), 100), seed);
+  using Dir = NdnTrafficCompare::Direction;
+
+  std::cout << "\n== Comparison Report (A=baseline, B=candidate) ==\n"
+            << "Per-run and throughput rows: Mann-Whitney U test and bootstrap CI of the delta.\n"
+            << "RTT rows: bootstrap over whole intervals of each run, judged on the CI alone (no p-value).\n\n";
+  cmp.printHeader(std::cout);
+
+  // per-run summary values, one sample per run
+  cmp.compare(std::cout, "ResponsesReceived (run)", baseline.getRunMetric("ResponsesReceived"),
+              candidate.getRunMetric("ResponsesReceived"), std::nullopt, Dir::HIGHER_IS_BETTER);
+  cmp.compare(std::cout, "InterestLoss% (run)", baseline.getRunMetric("InterestLoss(%)"),
+              candidate.getRunMetric("InterestLoss(%)"), std::nullopt, Dir::LOWER_IS_BETTER);
+  cmp.compare(std::cout, "AverageRTT ms (run)", baseline.getRunMetric("AverageRTT(ms)"),
+              candidate.getRunMetric("AverageRTT(ms)"), std::nullopt, Dir::LOWER_IS_BETTER);
+  cmp.compare(std::cout, "Goodput Mbit/s (run)", baseline.getRunMetric("Goodput(Mbit/s)"),
+              candidate.getRunMetric("Goodput(Mbit/s)"), std::nullopt, Dir::HIGHER_IS_BETTER);
+  cmp.compare(std::cout, "Jitter ms (run)", baseline.getRunMetric("Jitter(ms)"),
+              candidate.getRunMetric("Jitter(ms)"), std::nullopt, Dir::LOWER_IS_BETTER);
+
+  // per-interval samples pooled across runs
+  cmp.compare(std::cout, "Throughput Data/s", baseline.getThroughputSamples(),
+              candidate.getThroughputSamples(), std::nullopt, Dir::HIGHER_IS_BETTER);
+  // per-packet samples, correlated within an interval, so whole intervals are resampled
+  for (std::optional<double> p : {std::optional<double>(), std::optional<double>(50.0),
+                                  std::optional<double>(90.0), std::optional<double>(99.0)}) {
+    cmp.compareByInterval(std::cout, p ? "RTT p" + std::to_string(static_cast<int>(*p)) + " ms" : "RTT mean ms",
+                          baseline.getRttSamples(), baseline.getRttIntervals(),
+                          candidate.getRttSamples(), candidate.getRttIntervals(), p, Dir::LOWER_IS_BETTER);
+  }
+
+  std::cout << "\nSignificant Regressions     = " << cmp.getRegressionCount() << std::endl;
+  return cmp.getRegressionCount() > 0 ? 1 : 0;
+}
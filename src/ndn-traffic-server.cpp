@@ -1,6 +1,6 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 /*
- * Copyright (c) 2014-2023, Arizona Board of Regents.
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -18,26 +18,47 @@
  * Author: Jerald Paul Abraham <jeraldabraham@email.arizona.edu>
  */
 
+#include "content-header.hpp"
+#include "content-versions.hpp"
+#include "data-template.hpp"
+#include "fast-signer.hpp"
+#include "histogram.hpp"
+#include "mapped-file-cache.hpp"
+#include "sketch.hpp"
+#include "transport.hpp"
 #include "util.hpp"
+#include "value-distribution.hpp"
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/lp/nack.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/security/signing-info.hpp>
+#include <ndn-cxx/security/validator-config.hpp>
 #include <ndn-cxx/util/random.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <fstream>
 #include <limits>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <sstream>
 #include <thread>
 #include <vector>
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/core/noncopyable.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
@@ -71,6 +92,82 @@ public:
     m_contentDelay = delay;
   }
 
+  /**
+   * @brief Serves the patterns from @p nThreads worker threads, each with its own Face and KeyChain.
+   *
+   * Patterns are sharded round-robin over the workers, unless @p wantSharedPrefixes is set,
+   * in which case every worker registers every prefix and the forwarder strategy decides
+   * which worker receives each Interest.
+   */
+  void
+  setThreads(std::size_t nThreads, bool wantSharedPrefixes)
+  {
+    BOOST_ASSERT(nThreads > 0);
+    m_nThreads = nThreads;
+    m_wantSharedPrefixes = wantSharedPrefixes;
+  }
+
+  /**
+   * @brief Appends a row of per-interval statistics to @p file every @p interval.
+   */
+  void
+  setReportInterval(std::chrono::milliseconds interval, std::string file)
+  {
+    BOOST_ASSERT(interval > 0ms);
+    m_reportInterval = interval;
+    m_reportFile = std::move(file);
+  }
+
+  /**
+   * @brief Coalesces the Data produced in one event loop iteration into batched socket writes.
+   */
+  void
+  setBatching(const BatchingOptions& options)
+  {
+    m_batchingOptions = options;
+  }
+
+  /**
+   * @brief Signs every Data with KeyChain::sign() instead of the per-pattern FastSigner.
+   */
+  void
+  disableFastSigning()
+  {
+    m_wantFastSigning = false;
+  }
+
+  /**
+   * @brief Tracks unique names, arrivals per name and duplicate nonces among received Interests.
+   * @param nonceTableSize number of recent (name, nonce) pairs remembered to detect duplicates
+   */
+  void
+  enableArrivalStatistics(std::size_t nonceTableSize)
+  {
+    m_nonceTableSize = nonceTableSize;
+  }
+
+  /**
+   * @brief Limits the number and total size of the files mapped for each ContentDirectory pattern.
+   */
+  void
+  setFileCacheLimits(std::size_t maxFiles, std::size_t maxBytes)
+  {
+    m_fileCacheMaxFiles = maxFiles;
+    m_fileCacheMaxBytes = maxBytes;
+  }
+
+  /**
+   * @brief Validates every Interest against the trust policy in @p configFile before answering it.
+   *
+   * Interests that fail validation are dropped. Each worker's validator caches the certificates
+   * it has verified, so only the policy rules and the signature are checked for a known signer.
+   */
+  void
+  setInterestValidation(std::string configFile)
+  {
+    m_validatorConfigFile = std::move(configFile);
+  }
+
   void
   setTimestampFormat(std::string format)
   {
@@ -91,6 +188,9 @@ public:
     if (!readConfigurationFile(m_configurationFile, m_trafficPatterns, m_logger)) {
       return 2;
     }
+    for (auto& pattern : m_trafficPatterns) {
+      pattern.finalize();
+    }
 
     if (!checkTrafficPatternCorrectness()) {
       m_logger.log("ERROR: Traffic configuration provided is not proper", false, true);
@@ -109,6 +209,29 @@ public:
       return 0;
     }
 
+    if (m_nonceTableSize > 0) {
+      m_recentNonces = std::make_unique<RecentItemSet>(m_nonceTableSize);
+    }
+    for (const auto& pattern : m_trafficPatterns) {
+      m_fileCaches.push_back(pattern.hasContentDirectory() ?
+                             std::make_unique<MappedFileCache>(pattern.m_contentDirectory, m_fileCacheMaxFiles,
+                                                               m_fileCacheMaxBytes) : nullptr);
+      if (pattern.m_updateInterval > 0ms) {
+        m_contentVersions.push_back(ContentVersions::makeScheduled(pattern.m_updateInterval));
+      }
+      else if (pattern.m_updateRate > 0.0) {
+        m_contentVersions.push_back(ContentVersions::makePoisson(pattern.m_updateRate, pattern.m_nItems));
+      }
+      else {
+        m_contentVersions.push_back(nullptr);
+      }
+    }
+    if (std::any_of(m_trafficPatterns.begin(), m_trafficPatterns.end(),
+                    [] (const auto& pattern) { return pattern.hasVariableContentSize(); })) {
+      auto bytes = getRandomByteString(PAYLOAD_ARENA_SIZE + MAX_CONTENT_SIZE);
+      m_payloadArena.assign(bytes.begin(), bytes.end());
+    }
+
     m_signalSet.async_wait([this] (const boost::system::error_code&, int) {
       if (m_nMaximumInterests && m_nInterestsReceived < *m_nMaximumInterests) {
         m_hasError = true;
@@ -116,26 +239,121 @@ public:
       stop();
     });
 
+    // without shared prefixes, a worker without any pattern would sit idle
+    std::size_t nWorkers = m_wantSharedPrefixes ? m_nThreads : std::min(m_nThreads, m_trafficPatterns.size());
+    if (nWorkers < m_nThreads) {
+      m_logger.log("Using " + std::to_string(nWorkers) + " worker thread(s), one per traffic pattern", true, true);
+    }
+    for (std::size_t workerId = 0; workerId < nWorkers; workerId++) {
+      std::shared_ptr<BatchingTransport> transport;
+      if (m_batchingOptions.isEnabled()) {
+        try {
+          transport = makeBatchingTransport(getDefaultTransportUri(), m_batchingOptions);
+        }
+        catch (const std::exception& e) {
+          m_logger.log("ERROR: "s + e.what(), false, true);
+          return 2;
+        }
+      }
+      // worker #0 runs on the main thread and shares its io_context with the signal handler
+      m_workers.push_back(std::make_unique<Worker>(workerId == 0 ? &m_io : nullptr, std::move(transport),
+                                                   m_trafficPatterns.size()));
+      if (m_recentNonces != nullptr) {
+        m_workers.back()->arrivals.resize(m_trafficPatterns.size());
+        m_workers.back()->nameCounts.emplace(NAME_COUNTS_WIDTH, NAME_COUNTS_DEPTH);
+      }
+      if (!m_validatorConfigFile.empty()) {
+        // each worker fetches missing certificates through its own face
+        auto& validator = m_workers.back()->validator.emplace(m_workers.back()->face);
+        try {
+          validator.load(m_validatorConfigFile);
+        }
+        catch (const std::exception& e) {
+          m_logger.log("ERROR: cannot load the validator configuration: "s + e.what(), false, true);
+          return 2;
+        }
+      }
+    }
+
     for (std::size_t id = 0; id < m_trafficPatterns.size(); id++) {
-      m_registeredPrefixes.push_back(
-        m_face.setInterestFilter(m_trafficPatterns[id].m_name,
-                                 [this, id] (auto&&, const auto& interest) { onInterest(interest, id); },
-                                 nullptr,
-                                 [this, id] (auto&&, const auto& reason) { onRegisterFailed(reason, id); }));
+      // random content is drawn once per pattern and shared by every templated response
+      auto prototype = makeResponse(m_trafficPatterns[id], "/");
+      for (std::size_t workerId = 0; workerId < nWorkers; workerId++) {
+        if (!m_wantSharedPrefixes && id % nWorkers != workerId) {
+          continue;
+        }
+        auto& worker = *m_workers[workerId];
+        if (m_wantFastSigning) {
+          try {
+            auto& signer = worker.signers[id].emplace(worker.keyChain, m_trafficPatterns[id].m_signingInfoString);
+            // the MetaInfo is part of the template, so it must be the same for every response
+            if (signer.isFastPath() && !m_trafficPatterns[id].hasVariableFreshnessPeriod() &&
+                !m_trafficPatterns[id].hasContentDirectory()) {
+              prototype.setSignatureInfo(signer.getSignatureInfo());
+              worker.templates[id].emplace(prototype);
+            }
+          }
+          catch (const std::exception& e) {
+            m_logger.log("ERROR: Traffic Pattern Type #" + std::to_string(id + 1) +
+                         " cannot be signed: "s + e.what(), false, true);
+            return 2;
+          }
+        }
+        worker.registeredPrefixes.push_back(
+          worker.face.setInterestFilter(m_trafficPatterns[id].m_name,
+            [this, &worker, id] (auto&&, const auto& interest) { onInterest(worker, interest, id); },
+            nullptr,
+            [this, id] (auto&&, const auto& reason) { onRegisterFailed(reason, id); }));
+        m_nRegistrations++;
+      }
+    }
+
+    if (m_reportInterval > 0ms) {
+      m_reportOutput.open(m_reportFile, std::ofstream::out | std::ofstream::trunc);
+      if (!m_reportOutput) {
+        m_logger.log("ERROR: Unable to open the report file: " + m_reportFile, false, true);
+        return 2;
+      }
+      m_reportOutput << "Timestamp,Interests/s,DataBytes/s,MeanProcessingTime(ms),P99ProcessingTime(ms)\n";
+      m_lastReportTime = std::chrono::steady_clock::now();
+      scheduleReport();
+    }
+
+    for (std::size_t workerId = 1; workerId < nWorkers; workerId++) {
+      auto& worker = *m_workers[workerId];
+      worker.thread = std::thread([this, &worker] {
+        try {
+          worker.face.processEvents();
+        }
+        catch (const std::exception& e) {
+          m_logger.log("ERROR: "s + e.what(), true, true);
+          m_hasError = true;
+          boost::asio::post(m_io, [this] { stop(); });
+        }
+      });
     }
 
     try {
-      m_face.processEvents();
+      m_workers.front()->face.processEvents();
+      stopWorkers();
       return m_hasError ? 1 : 0;
     }
     catch (const std::exception& e) {
       m_logger.log("ERROR: "s + e.what(), true, true);
+      stopWorkers();
       m_io.stop();
       return 1;
     }
   }
 
 private:
+  enum class ResponseAction {
+    DATA,
+    DROP,
+    NACK,
+    LATE,
+  };
+
   class DataTrafficConfiguration
   {
   public:
@@ -150,18 +368,40 @@ private:
       if (m_contentDelay >= 0ms) {
         os << "ContentDelay=" << m_contentDelay.count() << ", ";
       }
-      if (m_freshnessPeriod >= 0_ms) {
-        os << "FreshnessPeriod=" << m_freshnessPeriod.count() << ", ";
+      if (m_freshnessPeriod) {
+        os << "FreshnessPeriod=" << m_freshnessPeriod->toString() << ", ";
       }
       if (m_contentType) {
         os << "ContentType=" << *m_contentType << ", ";
       }
-      if (m_contentLength) {
-        os << "ContentBytes=" << *m_contentLength << ", ";
+      if (m_contentSize) {
+        os << "ContentBytes=" << m_contentSize->toString() << ", ";
       }
       if (!m_content.empty()) {
         os << "Content=" << m_content << ", ";
       }
+      if (hasContentDirectory()) {
+        os << "ContentDirectory=" << m_contentDirectory << ", SegmentSize=" << m_segmentSize << ", ";
+      }
+      if (m_updateInterval > 0ms) {
+        os << "UpdateInterval=" << m_updateInterval.count() << ", ";
+      }
+      if (m_updateRate > 0.0) {
+        os << "UpdateRate=" << m_updateRate << ", ItemCount=" << m_nItems << ", ";
+      }
+      if (hasContentHeader()) {
+        os << "ContentHeader=yes, ";
+      }
+      if (m_dropProbability > 0.0) {
+        os << "DropProbability=" << m_dropProbability << ", ";
+      }
+      if (m_nackProbability > 0.0) {
+        os << "NackProbability=" << m_nackProbability << ", NackReason=" << m_nackReason << ", ";
+      }
+      if (m_lateResponseProbability > 0.0) {
+        os << "LateResponseProbability=" << m_lateResponseProbability << ", "
+           << "LateResponseDelay=" << m_lateResponseDelay.count() << ", ";
+      }
       os << "SigningInfo=" << m_signingInfo;
 
       logger.log(os.str(), false, false);
@@ -184,19 +424,79 @@ private:
         m_contentDelay = std::chrono::milliseconds(std::stoul(value));
       }
       else if (parameter == "FreshnessPeriod") {
-        m_freshnessPeriod = ndn::time::milliseconds(std::stoul(value));
+        try {
+          m_freshnessPeriod = ValueDistribution::parse(value);
+        }
+        catch (const std::invalid_argument& e) {
+          logger.log("Line " + std::to_string(lineNumber) + " - Invalid FreshnessPeriod: " + e.what(),
+                     false, true);
+          return false;
+        }
       }
       else if (parameter == "ContentType") {
         m_contentType = std::stoul(value);
       }
       else if (parameter == "ContentBytes") {
-        m_contentLength = std::stoul(value);
+        try {
+          m_contentSize = ValueDistribution::parse(value);
+        }
+        catch (const std::invalid_argument& e) {
+          logger.log("Line " + std::to_string(lineNumber) + " - Invalid ContentBytes: " + e.what(),
+                     false, true);
+          return false;
+        }
       }
       else if (parameter == "Content") {
         m_content = value;
       }
       else if (parameter == "SigningInfo") {
         m_signingInfo = ndn::security::SigningInfo(value);
+        m_signingInfoString = value;
+      }
+      else if (parameter == "ContentDirectory") {
+        m_contentDirectory = value;
+      }
+      else if (parameter == "SegmentSize") {
+        m_segmentSize = std::stoul(value);
+      }
+      else if (parameter == "UpdateInterval") {
+        m_updateInterval = std::chrono::milliseconds(std::stoul(value));
+      }
+      else if (parameter == "UpdateRate") {
+        m_updateRate = std::stod(value);
+      }
+      else if (parameter == "ItemCount") {
+        m_nItems = std::stoul(value);
+      }
+      else if (parameter == "ContentHeader") {
+        m_wantContentHeader = parseBoolean(value);
+      }
+      else if (parameter == "DropProbability") {
+        m_dropProbability = std::stod(value);
+      }
+      else if (parameter == "NackProbability") {
+        m_nackProbability = std::stod(value);
+      }
+      else if (parameter == "NackReason") {
+        if (boost::iequals(value, "Congestion")) {
+          m_nackReason = ndn::lp::NackReason::CONGESTION;
+        }
+        else if (boost::iequals(value, "Duplicate")) {
+          m_nackReason = ndn::lp::NackReason::DUPLICATE;
+        }
+        else if (boost::iequals(value, "NoRoute")) {
+          m_nackReason = ndn::lp::NackReason::NO_ROUTE;
+        }
+        else {
+          logger.log("Line " + std::to_string(lineNumber) + " - Invalid NackReason: " + value, false, true);
+          return false;
+        }
+      }
+      else if (parameter == "LateResponseProbability") {
+        m_lateResponseProbability = std::stod(value);
+      }
+      else if (parameter == "LateResponseDelay") {
+        m_lateResponseDelay = ndn::time::milliseconds(std::stoul(value));
       }
       else {
         logger.log("Line " + std::to_string(lineNumber) + " - Ignoring unknown parameter: " + parameter,
@@ -206,39 +506,404 @@ private:
     }
 
     bool
-    checkTrafficDetailCorrectness() const
+    checkTrafficDetailCorrectness(Logger& logger) const
     {
+      auto checkProbability = [&logger] (const std::string& parameter, double p) {
+        if (p >= 0.0 && p <= 1.0) {
+          return true;
+        }
+        logger.log("Invalid " + parameter + ": " + std::to_string(p) + " is not between 0 and 1", false, true);
+        return false;
+      };
+      if (!checkProbability("DropProbability", m_dropProbability) ||
+          !checkProbability("NackProbability", m_nackProbability) ||
+          !checkProbability("LateResponseProbability", m_lateResponseProbability)) {
+        return false;
+      }
+      if (m_dropProbability + m_nackProbability + m_lateResponseProbability > 1.0 + 1e-9) {
+        logger.log("Invalid response emulation: DropProbability, NackProbability and "
+                   "LateResponseProbability add up to more than 1", false, true);
+        return false;
+      }
+      // items change either on a schedule or at random, not both
+      if (m_updateInterval > 0ms && m_updateRate > 0.0) {
+        logger.log("Invalid content updates: UpdateInterval and UpdateRate cannot both be set", false, true);
+        return false;
+      }
+      if (m_updateRate < 0.0) {
+        logger.log("Invalid UpdateRate: " + std::to_string(m_updateRate), false, true);
+        return false;
+      }
+      if (m_nItems == 0) {
+        logger.log("Invalid ItemCount: 0", false, true);
+        return false;
+      }
+      if (m_segmentSize == 0 || m_segmentSize > MAX_CONTENT_SIZE) {
+        logger.log("Invalid SegmentSize: " + std::to_string(m_segmentSize) + " is not between 1 and " +
+                   std::to_string(MAX_CONTENT_SIZE), false, true);
+        return false;
+      }
       return true;
     }
 
+    /**
+     * @brief Computes the state derived from the parameters, once they have been checked.
+     */
+    void
+    finalize()
+    {
+      m_prefixLength = ndn::Name(m_name).size();
+
+      // cumulative thresholds over a 32-bit random draw, so each decision is one compare
+      auto toThreshold = [] (double p) {
+        return static_cast<uint64_t>(std::min(p, 1.0) * 4294967296.0);
+      };
+      m_dropThreshold = toThreshold(m_dropProbability);
+      m_nackThreshold = toThreshold(m_dropProbability + m_nackProbability);
+      m_lateThreshold = toThreshold(m_dropProbability + m_nackProbability + m_lateResponseProbability);
+    }
+
+    ResponseAction
+    selectResponse(uint32_t random) const
+    {
+      if (random < m_dropThreshold)
+        return ResponseAction::DROP;
+      if (random < m_nackThreshold)
+        return ResponseAction::NACK;
+      if (random < m_lateThreshold)
+        return ResponseAction::LATE;
+      return ResponseAction::DATA;
+    }
+
+    /**
+     * @brief Returns true if the FreshnessPeriod is drawn for every response.
+     */
+    bool
+    hasVariableFreshnessPeriod() const
+    {
+      return m_freshnessPeriod && !m_freshnessPeriod->isFixed();
+    }
+
+    /**
+     * @brief Returns true if responses are segments of the files below a directory.
+     */
+    bool
+    hasContentDirectory() const
+    {
+      return !m_contentDirectory.empty();
+    }
+
+    bool
+    hasContentUpdates() const
+    {
+      return m_updateInterval > 0ms || m_updateRate > 0.0;
+    }
+
+    /**
+     * @brief Returns true if every response starts with a ContentHeader.
+     */
+    bool
+    hasContentHeader() const
+    {
+      return !hasContentDirectory() && (m_wantContentHeader || hasContentUpdates());
+    }
+
+    /**
+     * @brief Returns true if the content size is drawn for every response.
+     */
+    bool
+    hasVariableContentSize() const
+    {
+      return !hasContentDirectory() && m_content.empty() && m_contentSize && !m_contentSize->isFixed();
+    }
+
+    bool
+    hasResponseEmulation() const
+    {
+      return m_lateThreshold > 0;
+    }
+
   public:
     std::string m_name;
     std::chrono::milliseconds m_contentDelay{-1};
-    ndn::time::milliseconds m_freshnessPeriod{-1};
+    std::optional<ValueDistribution> m_freshnessPeriod;
     std::optional<uint32_t> m_contentType;
-    std::optional<std::size_t> m_contentLength;
+    std::optional<ValueDistribution> m_contentSize;
     std::string m_content;
     ndn::security::SigningInfo m_signingInfo;
-    uint64_t m_nInterestsReceived = 0;
+    std::string m_signingInfoString;
+    std::chrono::milliseconds m_updateInterval{0};
+    double m_updateRate = 0.0; // updates per second of each item
+    std::size_t m_nItems = 1 << 20;
+    bool m_wantContentHeader = false;
+    std::string m_contentDirectory;
+    std::size_t m_segmentSize = 4096;
+    std::size_t m_prefixLength = 0; // number of components of m_name
+    double m_dropProbability = 0.0;
+    double m_nackProbability = 0.0;
+    ndn::lp::NackReason m_nackReason = ndn::lp::NackReason::CONGESTION;
+    double m_lateResponseProbability = 0.0;
+    ndn::time::milliseconds m_lateResponseDelay{4000};
+    uint64_t m_dropThreshold = 0;
+    uint64_t m_nackThreshold = 0;
+    uint64_t m_lateThreshold = 0;
+  };
+
+  /**
+   * @brief Interest-to-put processing time of one pattern, split into phases, in milliseconds.
+   */
+  struct ProcessingStatistics
+  {
+    Histogram build;
+    Histogram sign;
+    Histogram delay;
+    Histogram total;
+    Histogram validate; // from reception to the validation result, including certificate retrieval
   };
 
+  struct ResponseCounters
+  {
+    uint64_t nDropped = 0;
+    uint64_t nNacked = 0;
+    uint64_t nLate = 0;
+    uint64_t nNotFound = 0;
+    uint64_t nValidated = 0;
+    uint64_t nValidationFailures = 0;
+  };
+
+  struct ArrivalStatistics
+  {
+    HyperLogLog names;
+    uint64_t nDuplicateNonces = 0;
+    uint64_t maxArrivalsPerName = 0; // estimated by the worker's Count-Min sketch
+    std::chrono::steady_clock::time_point firstArrival = std::chrono::steady_clock::time_point::max();
+    std::chrono::steady_clock::time_point lastArrival;
+
+    void
+    merge(const ArrivalStatistics& other)
+    {
+      names.merge(other.names);
+      nDuplicateNonces += other.nDuplicateNonces;
+      maxArrivalsPerName = std::max(maxArrivalsPerName, other.maxArrivalsPerName);
+      firstArrival = std::min(firstArrival, other.firstArrival);
+      lastArrival = std::max(lastArrival, other.lastArrival);
+    }
+  };
+
+  struct IntervalStatistics
+  {
+    uint64_t nInterests = 0;
+    uint64_t nDataBytes = 0;
+    Histogram processing; // milliseconds
+  };
+
+  /**
+   * @brief State owned by one worker thread.
+   *
+   * Each worker has its own Face (and io_context, except worker #0 which uses the main one)
+   * and its own KeyChain handle, so that workers never contend on the event loop or on signing.
+   */
+  class Worker : boost::noncopyable
+  {
+  public:
+    /**
+     * @param transport batching transport, or nullptr to use the default ndn-cxx transport
+     */
+    Worker(boost::asio::io_context* io, std::shared_ptr<BatchingTransport> transport, std::size_t nPatterns)
+      : ownIo(io == nullptr ? std::make_unique<boost::asio::io_context>() : nullptr)
+      , batchingTransport(transport)
+      , face(std::move(transport), io == nullptr ? *ownIo : *io)
+      , nInterestsReceived(nPatterns, 0)
+      , signers(nPatterns)
+      , templates(nPatterns)
+      , responseCounters(nPatterns)
+      , processing(nPatterns)
+      , rngState(ndn::random::generateWord64())
+    {
+    }
+
+    /**
+     * @brief Returns 32 random bits from a SplitMix64 generator, cheap enough for every Interest.
+     */
+    uint32_t
+    drawRandom()
+    {
+      rngState += 0x9e3779b97f4a7c15ULL;
+      return static_cast<uint32_t>(mixHash(rngState) >> 32);
+    }
+
+  public:
+    std::unique_ptr<boost::asio::io_context> ownIo;
+    std::shared_ptr<BatchingTransport> batchingTransport;
+    ndn::Face face;
+    ndn::Scheduler scheduler{face.getIoContext()};
+    ndn::KeyChain keyChain;
+    std::optional<ndn::security::ValidatorConfig> validator; // set if Interests are validated
+    std::vector<ndn::ScopedRegisteredPrefixHandle> registeredPrefixes;
+    std::vector<uint64_t> nInterestsReceived; // per pattern, only written by the worker thread
+    std::vector<std::optional<FastSigner>> signers; // per pattern, unset if not served or disabled
+    std::vector<std::optional<DataTemplate>> templates; // per pattern, set if the signer has a fast path
+    std::vector<ResponseCounters> responseCounters; // per pattern, only written by the worker thread
+    std::vector<ProcessingStatistics> processing; // per pattern, only written by the worker thread
+    std::vector<ArrivalStatistics> arrivals; // per pattern, empty unless arrival statistics are enabled
+    std::optional<CountMinSketch> nameCounts; // arrivals per name hash, for all patterns of the worker
+    uint64_t rngState;
+    std::array<uint8_t, ContentHeader::SIZE> contentHeader; // of the response being built
+    std::mutex intervalMutex; // the report timer collects the interval from the main thread
+    IntervalStatistics interval;
+    std::thread thread;
+  };
+
+  static std::string
+  formatProcessingTime(const Histogram& histogram)
+  {
+    return std::to_string(histogram.getMean()) + "/" + std::to_string(histogram.getPercentile(50)) + "/" +
+           std::to_string(histogram.getPercentile(99)) + "ms";
+  }
+
   void
   logStatistics()
   {
     using std::to_string;
 
+    // per-pattern totals are merged from all workers
+    std::vector<uint64_t> nInterestsReceived(m_trafficPatterns.size(), 0);
+    std::vector<ProcessingStatistics> processing(m_trafficPatterns.size());
+    std::vector<ResponseCounters> responseCounters(m_trafficPatterns.size());
+    std::vector<ArrivalStatistics> arrivals(m_recentNonces != nullptr ? m_trafficPatterns.size() : 0);
+    for (const auto& worker : m_workers) {
+      for (std::size_t patternId = 0; patternId < arrivals.size(); patternId++) {
+        arrivals[patternId].merge(worker->arrivals[patternId]);
+      }
+      for (std::size_t patternId = 0; patternId < nInterestsReceived.size(); patternId++) {
+        nInterestsReceived[patternId] += worker->nInterestsReceived[patternId];
+        responseCounters[patternId].nDropped += worker->responseCounters[patternId].nDropped;
+        responseCounters[patternId].nNacked += worker->responseCounters[patternId].nNacked;
+        responseCounters[patternId].nLate += worker->responseCounters[patternId].nLate;
+        responseCounters[patternId].nNotFound += worker->responseCounters[patternId].nNotFound;
+        responseCounters[patternId].nValidated += worker->responseCounters[patternId].nValidated;
+        responseCounters[patternId].nValidationFailures += worker->responseCounters[patternId].nValidationFailures;
+        processing[patternId].build.merge(worker->processing[patternId].build);
+        processing[patternId].sign.merge(worker->processing[patternId].sign);
+        processing[patternId].delay.merge(worker->processing[patternId].delay);
+        processing[patternId].total.merge(worker->processing[patternId].total);
+        processing[patternId].validate.merge(worker->processing[patternId].validate);
+      }
+    }
+
     m_logger.log("\n\n== Traffic Report ==\n", false, true);
     m_logger.log("Total Traffic Pattern Types = " + to_string(m_trafficPatterns.size()), false, true);
     m_logger.log("Total Interests Received    = " + to_string(m_nInterestsReceived) + "\n", false, true);
 
+    if (m_batchingOptions.isEnabled()) {
+      BatchingCounters counters;
+      for (const auto& worker : m_workers) {
+        counters += worker->batchingTransport->getCounters();
+      }
+      double batchPackets = counters.nBatches > 0 ? double(counters.nPackets) / counters.nBatches : 0.0;
+      double batchBytes = counters.nBatches > 0 ? double(counters.nBytes) / counters.nBatches : 0.0;
+      m_logger.log("Total Write Batches         = " + to_string(counters.nBatches), false, true);
+      m_logger.log("Average Batch Size          = " + to_string(batchPackets) + " packets, " +
+                   to_string(batchBytes) + " bytes\n", false, true);
+    }
+
+    if (m_workers.size() > 1) {
+      for (std::size_t workerId = 0; workerId < m_workers.size(); workerId++) {
+        const auto& counts = m_workers[workerId]->nInterestsReceived;
+        m_logger.log("Worker #" + to_string(workerId + 1) + " Interests Received = " +
+                     to_string(std::accumulate(counts.begin(), counts.end(), uint64_t(0))), false, true);
+      }
+      m_logger.log("", false, true);
+    }
+
     for (std::size_t patternId = 0; patternId < m_trafficPatterns.size(); patternId++) {
       const auto& pattern = m_trafficPatterns[patternId];
 
       m_logger.log("Traffic Pattern Type #" + to_string(patternId + 1), false, true);
       pattern.printTrafficConfiguration(m_logger);
       m_logger.log("Total Interests Received    = " +
-                   to_string(pattern.m_nInterestsReceived) + "\n", false, true);
+                   to_string(nInterestsReceived[patternId]), false, true);
+      if (pattern.hasResponseEmulation()) {
+        const auto& counters = responseCounters[patternId];
+        m_logger.log("Interests Dropped           = " + to_string(counters.nDropped), false, true);
+        m_logger.log("Nacks Sent                  = " + to_string(counters.nNacked), false, true);
+        m_logger.log("Late Responses              = " + to_string(counters.nLate), false, true);
+      }
+      if (pattern.hasContentDirectory() && !m_fileCaches.empty()) {
+        auto counters = m_fileCaches[patternId]->getCounters();
+        m_logger.log("Segments Not Found          = " + to_string(responseCounters[patternId].nNotFound), false, true);
+        m_logger.log("File Cache hits/misses      = " + to_string(counters.nHits) + "/" +
+                     to_string(counters.nMisses), false, true);
+        m_logger.log("File Cache Evictions        = " + to_string(counters.nEvictions), false, true);
+      }
+      if (!m_validatorConfigFile.empty()) {
+        const auto& counters = responseCounters[patternId];
+        m_logger.log("Interests Validated         = " + to_string(counters.nValidated), false, true);
+        m_logger.log("Validation Failures         = " + to_string(counters.nValidationFailures), false, true);
+        if (processing[patternId].validate.getCount() > 0) {
+          m_logger.log("Validation Time mean/p50/p99 = " +
+                       formatProcessingTime(processing[patternId].validate), false, true);
+        }
+      }
+      if (!arrivals.empty() && nInterestsReceived[patternId] > 0) {
+        const auto& stats = arrivals[patternId];
+        double uniqueNames = std::max(stats.names.estimate(), 1.0);
+        double duration = std::chrono::duration<double>(stats.lastArrival - stats.firstArrival).count();
+        double rate = duration > 0.0 ? (nInterestsReceived[patternId] - 1) / duration : 0.0;
+        m_logger.log("Interest Arrival Rate       = " + to_string(rate) + "/s", false, true);
+        m_logger.log("Unique Names (estimated)    = " + to_string(std::llround(uniqueNames)), false, true);
+        m_logger.log("Arrivals per Name mean/max  = " + to_string(nInterestsReceived[patternId] / uniqueNames) +
+                     "/" + to_string(stats.maxArrivalsPerName), false, true);
+        m_logger.log("Duplicate Nonce Arrivals    = " + to_string(stats.nDuplicateNonces), false, true);
+      }
+      if (nInterestsReceived[patternId] > 0) {
+        const auto& stats = processing[patternId];
+        m_logger.log("Build Time mean/p50/p99     = " + formatProcessingTime(stats.build), false, true);
+        m_logger.log("Sign Time mean/p50/p99      = " + formatProcessingTime(stats.sign), false, true);
+        m_logger.log("Delay Time mean/p50/p99     = " + formatProcessingTime(stats.delay), false, true);
+        m_logger.log("Total Time mean/p50/p99     = " + formatProcessingTime(stats.total), false, true);
+      }
+      m_logger.log("", false, true);
+    }
+  }
+
+  void
+  scheduleReport()
+  {
+    m_reportTimer.expires_after(m_reportInterval);
+    m_reportTimer.async_wait([this] (const boost::system::error_code& ec) {
+      if (!ec) {
+        writeReport();
+        scheduleReport();
+      }
+    });
+  }
+
+  /**
+   * @brief Collects and resets the interval statistics of all workers and appends them to the report file.
+   */
+  void
+  writeReport()
+  {
+    IntervalStatistics interval;
+    for (const auto& worker : m_workers) {
+      std::lock_guard<std::mutex> lock(worker->intervalMutex);
+      interval.nInterests += worker->interval.nInterests;
+      interval.nDataBytes += worker->interval.nDataBytes;
+      interval.processing.merge(worker->interval.processing);
+      worker->interval = IntervalStatistics();
     }
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - m_lastReportTime).count();
+    m_lastReportTime = now;
+
+    using namespace ndn::time;
+    m_reportOutput << toUnixTimestamp<microseconds>(system_clock::now()).count() / 1e6 << ','
+                   << interval.nInterests / elapsed << ','
+                   << interval.nDataBytes / elapsed << ','
+                   << interval.processing.getMean() << ','
+                   << interval.processing.getPercentile(99) << std::endl;
   }
 
   bool
@@ -252,8 +917,8 @@ private:
   getRandomByteString(std::size_t length)
   {
     // per ISO C++ std, cannot instantiate uniform_int_distribution with char
-    static std::uniform_int_distribution<short> dist(std::numeric_limits<char>::min(),
-                                                     std::numeric_limits<char>::max());
+    thread_local std::uniform_int_distribution<short> dist(std::numeric_limits<char>::min(),
+                                                           std::numeric_limits<char>::max());
 
     std::string s;
     s.reserve(length);
@@ -263,52 +928,395 @@ private:
     return s;
   }
 
-  void
-  onInterest(const ndn::Interest& interest, std::size_t patternId)
+  /**
+   * @brief Reserves the next global Interest number, unless the maximum count has been reached.
+   * @return the reserved number (starting at 1), or zero if the Interest must not be answered
+   */
+  uint64_t
+  admitInterest()
   {
-    auto& pattern = m_trafficPatterns[patternId];
+    uint64_t nReceived = m_nInterestsReceived.load(std::memory_order_relaxed);
+    do {
+      if (m_nMaximumInterests && nReceived >= *m_nMaximumInterests) {
+        return 0;
+      }
+    } while (!m_nInterestsReceived.compare_exchange_weak(nReceived, nReceived + 1,
+                                                         std::memory_order_relaxed));
+    return nReceived + 1;
+  }
 
-    if (!m_nMaximumInterests || m_nInterestsReceived < *m_nMaximumInterests) {
-      ndn::Data data(interest.getName());
+  /**
+   * @brief Returns a random slice of the payload arena, with a size drawn from the pattern's distribution.
+   */
+  ndn::span<const uint8_t>
+  selectPayload(Worker& worker, const DataTrafficConfiguration& pattern) const
+  {
+    double sample = pattern.m_contentSize->sample(ndn::random::getRandomNumberEngine());
+    auto size = static_cast<std::size_t>(std::clamp(sample, 0.0, double(MAX_CONTENT_SIZE)));
+    auto offset = worker.drawRandom() % (m_payloadArena.size() - size + 1);
+    return {m_payloadArena.data() + offset, size};
+  }
 
-      if (pattern.m_freshnessPeriod >= 0_ms)
-        data.setFreshnessPeriod(pattern.m_freshnessPeriod);
+  /**
+   * @brief Returns the segment named @p name of a file below the pattern's ContentDirectory,
+   *        or an application-level Nack if there is no such segment.
+   *
+   * The components after the prefix, except a trailing segment number, form the relative path.
+   */
+  ndn::Data
+  makeFileResponse(Worker& worker, const ndn::Name& name, std::size_t patternId)
+  {
+    const auto& pattern = m_trafficPatterns[patternId];
+    ndn::Data data(name);
 
-      if (pattern.m_contentType)
-        data.setContentType(*pattern.m_contentType);
+    if (pattern.m_freshnessPeriod)
+      data.setFreshnessPeriod(ndn::time::milliseconds(static_cast<int64_t>(
+                                pattern.m_freshnessPeriod->sample(ndn::random::getRandomNumberEngine()))));
 
-      std::string content;
-      if (pattern.m_contentLength > 0)
-        content = getRandomByteString(*pattern.m_contentLength);
-      if (!pattern.m_content.empty())
-        content = pattern.m_content;
-      data.setContent(ndn::makeStringBlock(ndn::tlv::Content, content));
+    if (pattern.m_contentType)
+      data.setContentType(*pattern.m_contentType);
 
-      m_keyChain.sign(data, pattern.m_signingInfo);
+    uint64_t segment = 0;
+    std::size_t pathEnd = name.size();
+    if (pathEnd > pattern.m_prefixLength && name.get(-1).isSegment()) {
+      segment = name.get(-1).toSegment();
+      pathEnd--;
+    }
+
+    // names must not escape the directory, e.g. with a ".." component
+    std::string path;
+    bool isSafe = pathEnd > pattern.m_prefixLength;
+    for (std::size_t i = pattern.m_prefixLength; i < pathEnd && isSafe; i++) {
+      std::string_view component(reinterpret_cast<const char*>(name.get(i).value()), name.get(i).value_size());
+      isSafe = MappedFileCache::isSafePathComponent(component);
+      if (!path.empty()) {
+        path += '/';
+      }
+      path += component;
+    }
+
+    std::shared_ptr<const MappedFile> file;
+    if (isSafe) {
+      file = m_fileCaches[patternId]->get(path);
+    }
+    uint64_t nSegments = file == nullptr ? 0 :
+                         std::max<uint64_t>((file->size() + pattern.m_segmentSize - 1) / pattern.m_segmentSize, 1);
+    if (segment >= nSegments) {
+      worker.responseCounters[patternId].nNotFound++;
+      data.setContentType(ndn::tlv::ContentType_Nack);
+      return data;
+    }
+
+    // the only copy of the file bytes is into the encoded packet
+    std::size_t offset = segment * pattern.m_segmentSize;
+    data.setContent({file->data() + offset, std::min(pattern.m_segmentSize, file->size() - offset)});
+    data.setFinalBlock(ndn::name::Component::fromSegment(nSegments - 1));
+    return data;
+  }
 
-      m_nInterestsReceived++;
-      pattern.m_nInterestsReceived++;
+  /**
+   * @brief Encodes the ContentHeader of a response to @p name into the worker's buffer.
+   */
+  ndn::span<const uint8_t>
+  makeContentHeader(Worker& worker, const ndn::Name& name, std::size_t patternId)
+  {
+    using namespace std::chrono;
+
+    auto now = duration_cast<microseconds>(system_clock::now().time_since_epoch());
+    ContentHeader header;
+    header.generationTime = now.count();
+    if (const auto& versions = m_contentVersions[patternId]; versions) {
+      const auto& wire = name.wireEncode();
+      auto itemHash = mixHash(hashBytes({reinterpret_cast<const char*>(wire.data()), wire.size()}));
+      auto version = versions->get(itemHash, ndn::random::getRandomNumberEngine());
+      header.version = version.number;
+      header.validUntil = (now + version.remaining).count();
+    }
+    header.encode(worker.contentHeader.data());
+    return worker.contentHeader;
+  }
+
+  /**
+   * @param header ContentHeader placed before the content, if the pattern has one
+   * @param payload content of a pattern with a variable content size
+   */
+  static ndn::Data
+  makeResponse(const DataTrafficConfiguration& pattern, const ndn::Name& name,
+               ndn::span<const uint8_t> header = {}, ndn::span<const uint8_t> payload = {})
+  {
+    ndn::Data data(name);
+
+    if (pattern.m_freshnessPeriod)
+      data.setFreshnessPeriod(ndn::time::milliseconds(static_cast<int64_t>(
+                                pattern.m_freshnessPeriod->sample(ndn::random::getRandomNumberEngine()))));
+
+    if (pattern.m_contentType)
+      data.setContentType(*pattern.m_contentType);
+
+    std::string content;
+    if (pattern.m_contentSize && !pattern.hasVariableContentSize())
+      content = getRandomByteString(static_cast<std::size_t>(pattern.m_contentSize->sample(
+                                      ndn::random::getRandomNumberEngine())));
+    if (!pattern.m_content.empty())
+      content = pattern.m_content;
+    if (!pattern.hasVariableContentSize())
+      payload = {reinterpret_cast<const uint8_t*>(content.data()), content.size()};
+
+    if (header.empty()) {
+      data.setContent(payload);
+    }
+    else {
+      std::vector<uint8_t> buffer(header.begin(), header.end());
+      buffer.insert(buffer.end(), payload.begin(), payload.end());
+      data.setContent(buffer);
+    }
+    return data;
+  }
+
+  void
+  onInterest(Worker& worker, const ndn::Interest& interest, std::size_t patternId)
+  {
+    if (uint64_t globalRef = admitInterest(); globalRef > 0) {
+      uint64_t localRef = ++worker.nInterestsReceived[patternId];
 
       if (!m_wantQuiet) {
         auto logLine = "Interest Received          - PatternType=" + std::to_string(patternId + 1) +
-                       ", GlobalID=" + std::to_string(m_nInterestsReceived) +
-                       ", LocalID=" + std::to_string(pattern.m_nInterestsReceived) +
+                       ", GlobalID=" + std::to_string(globalRef) +
+                       ", LocalID=" + std::to_string(localRef) +
                        ", Name=" + interest.getName().toUri();
         m_logger.log(logLine, true, false);
       }
 
-      if (pattern.m_contentDelay > 0ms)
-        std::this_thread::sleep_for(pattern.m_contentDelay);
-      if (m_contentDelay > 0ms)
-        std::this_thread::sleep_for(m_contentDelay);
+      if (m_reportInterval > 0ms) {
+        std::lock_guard<std::mutex> lock(worker.intervalMutex);
+        worker.interval.nInterests++;
+      }
+      if (m_recentNonces != nullptr) {
+        recordArrival(worker, interest, patternId);
+      }
 
-      m_face.put(data);
+      if (worker.validator) {
+        validateInterest(worker, interest, patternId, globalRef);
+      }
+      else {
+        respond(worker, interest, patternId, globalRef);
+      }
     }
+  }
 
-    if (m_nMaximumInterests && m_nInterestsReceived >= *m_nMaximumInterests) {
-      logStatistics();
-      m_registeredPrefixes.clear();
-      m_signalSet.cancel();
+  /**
+   * @brief Answers an admitted Interest as the pattern's response emulation decides.
+   */
+  void
+  respond(Worker& worker, const ndn::Interest& interest, std::size_t patternId, uint64_t globalRef)
+  {
+    const auto& pattern = m_trafficPatterns[patternId];
+
+    auto& counters = worker.responseCounters[patternId];
+    switch (pattern.selectResponse(worker.drawRandom())) {
+      case ResponseAction::DROP:
+        counters.nDropped++;
+        break;
+      case ResponseAction::NACK: {
+        ndn::lp::Nack nack(interest);
+        nack.setReason(pattern.m_nackReason);
+        worker.face.put(nack);
+        counters.nNacked++;
+        break;
+      }
+      case ResponseAction::LATE:
+        counters.nLate++;
+        sendData(worker, interest, patternId, true);
+        break;
+      case ResponseAction::DATA:
+        sendData(worker, interest, patternId, false);
+        break;
+    }
+    checkLastInterest(globalRef);
+  }
+
+  void
+  checkLastInterest(uint64_t globalRef)
+  {
+    if (m_nMaximumInterests && globalRef == *m_nMaximumInterests) {
+      // exactly one worker admits the last Interest; the main thread wraps up
+      boost::asio::post(m_io, [this] { finish(); });
+    }
+  }
+
+  /**
+   * @brief Validates @p interest, then answers it from the worker thread if it is valid.
+   *
+   * The worker's validator applies the whole trust policy, including the signed Interest
+   * timestamp and nonce checks, and retrieves certificates if needed.
+   */
+  void
+  validateInterest(Worker& worker, const ndn::Interest& interest, std::size_t patternId, uint64_t globalRef)
+  {
+    auto startTime = std::chrono::steady_clock::now();
+    worker.validator->validate(interest,
+      [=, &worker] (const ndn::Interest& validated) {
+        onValidated(worker, validated, patternId, globalRef, startTime, "");
+      },
+      [=, &worker] (const ndn::Interest& failed, const ndn::security::ValidationError& error) {
+        onValidated(worker, failed, patternId, globalRef, startTime, boost::lexical_cast<std::string>(error));
+      });
+  }
+
+  /**
+   * @param error reason why validation failed, or empty if @p interest is valid
+   */
+  void
+  onValidated(Worker& worker, const ndn::Interest& interest, std::size_t patternId, uint64_t globalRef,
+              std::chrono::steady_clock::time_point startTime, const std::string& error)
+  {
+    worker.processing[patternId].validate.record(
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+
+    if (error.empty()) {
+      worker.responseCounters[patternId].nValidated++;
+      respond(worker, interest, patternId, globalRef);
+      return;
+    }
+
+    worker.responseCounters[patternId].nValidationFailures++;
+    if (!m_wantQuiet) {
+      m_logger.log("Interest Validation Failed - PatternType=" + std::to_string(patternId + 1) +
+                   ", Name=" + interest.getName().toUri() + ", Reason=" + error, true, false);
+    }
+    checkLastInterest(globalRef);
+  }
+
+  void
+  recordArrival(Worker& worker, const ndn::Interest& interest, std::size_t patternId)
+  {
+    const auto& wire = interest.getName().wireEncode();
+    uint64_t nameHash = hashBytes({reinterpret_cast<const char*>(wire.data()), wire.size()});
+    auto nonce = interest.getNonce();
+    uint64_t nonceHash = hashBytes({reinterpret_cast<const char*>(nonce.data()), nonce.size()});
+
+    auto& stats = worker.arrivals[patternId];
+    stats.names.add(nameHash);
+    stats.maxArrivalsPerName = std::max(stats.maxArrivalsPerName, worker.nameCounts->add(nameHash));
+    // the set is shared, so a duplicate is detected even if another worker received the first copy
+    if (m_recentNonces->insert(mixHash(nameHash ^ nonceHash))) {
+      stats.nDuplicateNonces++;
+    }
+    auto now = std::chrono::steady_clock::now();
+    stats.firstArrival = std::min(stats.firstArrival, now);
+    stats.lastArrival = now;
+  }
+
+  /**
+   * @brief Builds, signs and sends the Data answering @p interest.
+   * @param isLate whether the Data is sent after the pattern's LateResponseDelay
+   */
+  void
+  sendData(Worker& worker, const ndn::Interest& interest, std::size_t patternId, bool isLate)
+  {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const auto& pattern = m_trafficPatterns[patternId];
+
+    auto startTime = std::chrono::steady_clock::now();
+    double buildTime = 0.0;
+    double signTime = 0.0;
+
+    ndn::span<const uint8_t> header;
+    if (pattern.hasContentHeader()) {
+      header = makeContentHeader(worker, interest.getName(), patternId);
+    }
+    ndn::span<const uint8_t> payload;
+    if (pattern.hasVariableContentSize()) {
+      payload = selectPayload(worker, pattern);
+    }
+
+    ndn::Data data;
+    if (auto& dataTemplate = worker.templates[patternId]; dataTemplate) {
+      // sign over the Interest name and the template, then assemble the packet in one buffer
+      auto& signer = *worker.signers[patternId];
+      bool isVariable = pattern.hasContentHeader() || pattern.hasVariableContentSize();
+      if (isVariable && !pattern.hasVariableContentSize()) {
+        payload = dataTemplate->getContentValue();
+      }
+      auto signature = isVariable ?
+                       signer.computeSignature(dataTemplate->getSignedPortion(interest.getName(), header, payload)) :
+                       signer.computeSignature(dataTemplate->getSignedPortion(interest.getName()));
+      auto signedTime = std::chrono::steady_clock::now();
+      data = isVariable ?
+             dataTemplate->makeData(interest.getName(), header, payload, signature) :
+             dataTemplate->makeData(interest.getName(), signature);
+      signTime = Milliseconds(signedTime - startTime).count();
+      buildTime = Milliseconds(std::chrono::steady_clock::now() - signedTime).count();
+    }
+    else {
+      data = pattern.hasContentDirectory() ? makeFileResponse(worker, interest.getName(), patternId) :
+                                            makeResponse(pattern, interest.getName(), header, payload);
+      auto builtTime = std::chrono::steady_clock::now();
+      if (auto& signer = worker.signers[patternId]; signer) {
+        signer->sign(data);
+      }
+      else {
+        worker.keyChain.sign(data, pattern.m_signingInfo);
+      }
+      buildTime = Milliseconds(builtTime - startTime).count();
+      signTime = Milliseconds(std::chrono::steady_clock::now() - builtTime).count();
+    }
+
+    auto delayStartTime = std::chrono::steady_clock::now();
+    if (pattern.m_contentDelay > 0ms)
+      std::this_thread::sleep_for(pattern.m_contentDelay);
+    if (m_contentDelay > 0ms)
+      std::this_thread::sleep_for(m_contentDelay);
+    auto delayEndTime = std::chrono::steady_clock::now();
+
+    if (isLate) {
+      worker.scheduler.schedule(pattern.m_lateResponseDelay, [&worker, data] { worker.face.put(data); });
+    }
+    else {
+      worker.face.put(data);
+    }
+
+    double totalTime = Milliseconds(std::chrono::steady_clock::now() - startTime).count();
+    auto& stats = worker.processing[patternId];
+    stats.build.record(buildTime);
+    stats.sign.record(signTime);
+    stats.delay.record(Milliseconds(delayEndTime - delayStartTime).count());
+    stats.total.record(totalTime);
+
+    if (m_reportInterval > 0ms) {
+      std::lock_guard<std::mutex> lock(worker.intervalMutex);
+      worker.interval.nDataBytes += data.wireEncode().size();
+      worker.interval.processing.record(totalTime);
+    }
+  }
+
+  void
+  finish()
+  {
+    stopWorkers();
+    logStatistics();
+    m_workers.front()->registeredPrefixes.clear();
+    m_signalSet.cancel();
+    m_reportTimer.cancel();
+  }
+
+  /**
+   * @brief Shuts down the faces of all worker threads other than #0 and waits for them to exit.
+   */
+  void
+  stopWorkers()
+  {
+    for (std::size_t workerId = 1; workerId < m_workers.size(); workerId++) {
+      auto& worker = *m_workers[workerId];
+      if (!worker.thread.joinable()) {
+        continue;
+      }
+      boost::asio::post(*worker.ownIo, [&worker] {
+        worker.registeredPrefixes.clear();
+        worker.face.shutdown();
+        worker.ownIo->stop();
+      });
+      worker.thread.join();
     }
   }
 
@@ -320,18 +1328,20 @@ private:
                    ", Reason=" + reason;
     m_logger.log(logLine, true, true);
 
-    m_nRegistrationsFailed++;
-    if (m_nRegistrationsFailed == m_trafficPatterns.size()) {
+    if (++m_nRegistrationsFailed == m_nRegistrations) {
       m_hasError = true;
-      stop();
+      boost::asio::post(m_io, [this] { stop(); });
     }
   }
 
   void
   stop()
   {
+    stopWorkers();
     logStatistics();
-    m_face.shutdown();
+    if (!m_workers.empty()) {
+      m_workers.front()->face.shutdown();
+    }
     m_io.stop();
   }
 
@@ -339,21 +1349,43 @@ private:
   Logger m_logger{"NdnTrafficServer"};
   boost::asio::io_context m_io;
   boost::asio::signal_set m_signalSet{m_io, SIGINT, SIGTERM};
-  ndn::Face m_face{m_io};
-  ndn::KeyChain m_keyChain;
+  boost::asio::steady_timer m_reportTimer{m_io};
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::size_t m_nThreads = 1;
+  bool m_wantSharedPrefixes = false;
+  bool m_wantFastSigning = true;
+  std::size_t m_nonceTableSize = 0; // zero disables arrival statistics
+  std::unique_ptr<RecentItemSet> m_recentNonces;
+  static constexpr std::size_t NAME_COUNTS_WIDTH = 1 << 16;
+  static constexpr std::size_t NAME_COUNTS_DEPTH = 4;
+  BatchingOptions m_batchingOptions;
 
   std::string m_configurationFile;
   std::string m_timestampFormat;
   std::optional<uint64_t> m_nMaximumInterests;
   std::chrono::milliseconds m_contentDelay{0};
+  std::chrono::milliseconds m_reportInterval{0};
+  std::string m_reportFile;
+  std::ofstream m_reportOutput;
+  std::chrono::steady_clock::time_point m_lastReportTime;
 
   std::vector<DataTrafficConfiguration> m_trafficPatterns;
-  std::vector<ndn::ScopedRegisteredPrefixHandle> m_registeredPrefixes;
-  uint64_t m_nRegistrationsFailed = 0;
-  uint64_t m_nInterestsReceived = 0;
+  // variable-size contents are random slices of one shared buffer, read-only once the workers start
+  static constexpr std::size_t PAYLOAD_ARENA_SIZE = 1 << 20;
+  // leaves room for the name and the signature within ndn::MAX_NDN_PACKET_SIZE
+  static constexpr std::size_t MAX_CONTENT_SIZE = 8000;
+  std::vector<uint8_t> m_payloadArena;
+  std::vector<std::unique_ptr<ContentVersions>> m_contentVersions; // per pattern, null if the content never changes
+  std::vector<std::unique_ptr<MappedFileCache>> m_fileCaches; // per pattern, null without a ContentDirectory
+  std::size_t m_fileCacheMaxFiles = 1024;
+  std::size_t m_fileCacheMaxBytes = std::size_t(1) << 30;
+  std::string m_validatorConfigFile; // empty disables Interest validation
+  uint64_t m_nRegistrations = 0;
+  std::atomic<uint64_t> m_nRegistrationsFailed{0};
+  std::atomic<uint64_t> m_nInterestsReceived{0};
 
   bool m_wantQuiet = false;
-  bool m_hasError = false;
+  std::atomic<bool> m_hasError{false};
 };
 
 } // namespace ndntg
@@ -386,6 +1418,32 @@ main(int argc, char* argv[])
                   "wait this amount of milliseconds before responding to each Interest")
     ("timestamp-format,t", po::value<std::string>(&timestampFormat), "format string for timestamp output")
     ("quiet,q",   po::bool_switch(), "turn off logging of Interest reception and Data generation")
+    ("threads",   po::value<std::size_t>()->default_value(1),
+                  "number of worker threads, each with its own face and KeyChain")
+    ("shared-prefix", po::bool_switch(),
+                  "register every prefix on every worker thread instead of sharding the patterns")
+    ("batch-bytes", po::value<std::size_t>()->default_value(0),
+                  "coalesce outgoing packets into one socket write of up to this many bytes (0 = off)")
+    ("batch-delay", po::value<int64_t>()->default_value(0),
+                  "with --batch-bytes, delay in microseconds before a partial batch is written "
+                  "(0 = end of the event loop iteration)")
+    ("no-fast-signing", po::bool_switch(),
+                  "sign every Data with KeyChain::sign() instead of reusing the precomputed SignatureInfo")
+    ("report-interval", po::value<std::chrono::milliseconds::rep>()->default_value(0),
+                  "write throughput and processing time to the report file every this many milliseconds (0 = off)")
+    ("report-file", po::value<std::string>()->default_value("server-timeseries.csv"),
+                  "file receiving the per-interval report")
+    ("file-cache-files", po::value<std::size_t>()->default_value(1024),
+                  "maximum number of files mapped for each ContentDirectory pattern")
+    ("file-cache-size", po::value<std::size_t>()->default_value(1024),
+                  "maximum total size in MiB of the files mapped for each ContentDirectory pattern")
+    ("arrival-stats", po::bool_switch(),
+                  "report the Interest arrival rate, unique names, arrivals per name and duplicate nonces")
+    ("nonce-table-size", po::value<std::size_t>()->default_value(1 << 20),
+                  "with --arrival-stats, number of recent (name, nonce) pairs remembered to detect duplicates")
+    ("validator-config", po::value<std::string>(),
+                  "validate every Interest against the trust policy in this ndn-cxx validator "
+                  "configuration file and drop those that fail")
     ;
 
   po::options_description hiddenOptions;
@@ -443,6 +1501,49 @@ main(int argc, char* argv[])
     server.setContentDelay(delay);
   }
 
+  if (vm["threads"].as<std::size_t>() == 0) {
+    std::cerr << "ERROR: the argument for option '--threads' must be positive\n";
+    return 2;
+  }
+  server.setThreads(vm["threads"].as<std::size_t>(), vm["shared-prefix"].as<bool>());
+
+  std::chrono::milliseconds reportInterval(vm["report-interval"].as<std::chrono::milliseconds::rep>());
+  if (reportInterval < 0ms) {
+    std::cerr << "ERROR: the argument for option '--report-interval' cannot be negative\n";
+    return 2;
+  }
+  if (reportInterval > 0ms) {
+    server.setReportInterval(reportInterval, vm["report-file"].as<std::string>());
+  }
+
+  if (vm["batch-delay"].as<int64_t>() < 0) {
+    std::cerr << "ERROR: the argument for option '--batch-delay' cannot be negative\n";
+    return 2;
+  }
+  ndntg::BatchingOptions batching;
+  batching.maxBytes = vm["batch-bytes"].as<std::size_t>();
+  batching.maxDelay = std::chrono::microseconds(vm["batch-delay"].as<int64_t>());
+  server.setBatching(batching);
+
+  if (vm["no-fast-signing"].as<bool>()) {
+    server.disableFastSigning();
+  }
+
+  server.setFileCacheLimits(vm["file-cache-files"].as<std::size_t>(),
+                            vm["file-cache-size"].as<std::size_t>() << 20);
+
+  if (vm["arrival-stats"].as<bool>()) {
+    if (vm["nonce-table-size"].as<std::size_t>() == 0) {
+      std::cerr << "ERROR: the argument for option '--nonce-table-size' must be positive\n";
+      return 2;
+    }
+    server.enableArrivalStatistics(vm["nonce-table-size"].as<std::size_t>());
+  }
+
+  if (vm.count("validator-config") > 0) {
+    server.setInterestValidation(vm["validator-config"].as<std::string>());
+  }
+
   if (!timestampFormat.empty()) {
     server.setTimestampFormat(std::move(timestampFormat));
   }
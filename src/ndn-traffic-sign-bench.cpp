@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fast-signer.hpp"
+#include "histogram.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/key-params.hpp>
+#include <ndn-cxx/security/signing-info.hpp>
+#include <ndn-cxx/security/transform/base64-encode.hpp>
+#include <ndn-cxx/security/transform/buffer-source.hpp>
+#include <ndn-cxx/security/transform/stream-sink.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <boost/program_options/variables_map.hpp>
+
+namespace ndntg {
+
+/**
+ * @brief Measures KeyChain::sign() throughput on Data packets like those built by ndn-traffic-server.
+ *
+ * Every thread owns an in-memory KeyChain ("pib-memory:", "tpm-memory:") with its own key,
+ * as every ndn-traffic-server worker owns its KeyChain, so no system PIB is needed and
+ * threads never share signing state.
+ */
+class NdnTrafficSignBench : boost::noncopyable
+{
+public:
+  struct Result
+  {
+    uint64_t nSignatures = 0;
+    double wallTime = 0.0; // seconds
+    double cpuTime = 0.0;  // seconds, all threads
+    Histogram latency;     // microseconds
+  };
+
+  NdnTrafficSignBench(std::chrono::milliseconds duration, bool wantFastSigner)
+    : m_duration(duration)
+    , m_wantFastSigner(wantFastSigner)
+    , m_hmacKey(makeHmacKey())
+  {
+  }
+
+  static const std::vector<std::string>&
+  getSupportedTypes()
+  {
+    static const std::vector<std::string> types{
+      "sha256", "hmac", "ecdsa-256", "ecdsa-384", "rsa-2048", "rsa-3072", "rsa-4096",
+    };
+    return types;
+  }
+
+  Result
+  run(const std::string& type, std::size_t contentSize, unsigned nThreads)
+  {
+    std::promise<void> startSignal;
+    std::shared_future<void> start = startSignal.get_future().share();
+    std::atomic<bool> isStopped{false};
+    std::atomic<unsigned> nReady{0};
+
+    std::vector<Result> results(nThreads);
+    std::vector<std::exception_ptr> errors(nThreads);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < nThreads; i++) {
+      threads.emplace_back([&, i] {
+        // key generation happens before the measurement starts
+        std::unique_ptr<ndn::KeyChain> keyChain;
+        ndn::security::SigningInfo signingInfo;
+        std::optional<FastSigner> fastSigner;
+        try {
+          keyChain = std::make_unique<ndn::KeyChain>("pib-memory:", "tpm-memory:");
+          auto signingInfoString = makeSigningInfo(*keyChain, type);
+          signingInfo = ndn::security::SigningInfo(signingInfoString);
+          if (m_wantFastSigner) {
+            fastSigner.emplace(*keyChain, signingInfoString);
+          }
+        }
+        catch (const std::exception&) {
+          errors[i] = std::current_exception();
+          nReady++;
+          return;
+        }
+        auto content = ndn::makeStringBlock(ndn::tlv::Content, makeRandomContent(contentSize));
+        ndn::Name prefix("/ndntg/sign-bench/" + type);
+
+        nReady++;
+        start.wait();
+
+        auto& result = results[i];
+        for (uint64_t seq = 0; !isStopped.load(std::memory_order_relaxed); seq++) {
+          // same steps as NdnTrafficServer::onInterest()
+          ndn::Data data(ndn::Name(prefix).appendNumber(seq));
+          data.setContent(content);
+
+          auto t0 = std::chrono::steady_clock::now();
+          try {
+            if (fastSigner) {
+              fastSigner->sign(data);
+            }
+            else {
+              keyChain->sign(data, signingInfo);
+            }
+          }
+          catch (const std::exception&) {
+            errors[i] = std::current_exception();
+            break;
+          }
+          auto t1 = std::chrono::steady_clock::now();
+
+          result.latency.record(std::chrono::duration<double, std::micro>(t1 - t0).count());
+          result.nSignatures++;
+        }
+      });
+    }
+
+    while (nReady < nThreads) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    double cpuStart = getCpuTime();
+    auto wallStart = std::chrono::steady_clock::now();
+    startSignal.set_value();
+    std::this_thread::sleep_for(m_duration);
+    isStopped = true;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    Result total;
+    total.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    total.cpuTime = getCpuTime() - cpuStart;
+    for (const auto& result : results) {
+      total.nSignatures += result.nSignatures;
+      total.latency.merge(result.latency);
+    }
+    return total;
+  }
+
+private:
+  /**
+   * @brief Creates the key for @p type if needed and returns the signing parameters
+   *        in the SigningInfo string format used by traffic configuration files.
+   */
+  std::string
+  makeSigningInfo(ndn::KeyChain& keyChain, const std::string& type) const
+  {
+    if (type == "sha256") {
+      return "id:/localhost/identity/digest-sha256";
+    }
+    if (type == "hmac") {
+      return "hmac-sha256:" + m_hmacKey;
+    }
+
+    auto dash = type.find('-');
+    auto keySize = static_cast<uint32_t>(std::stoul(type.substr(dash + 1)));
+    ndn::Name identityName("/ndntg/sign-bench/" + type);
+    if (type.compare(0, dash, "ecdsa") == 0) {
+      keyChain.createIdentity(identityName, ndn::EcKeyParams(keySize));
+    }
+    else {
+      keyChain.createIdentity(identityName, ndn::RsaKeyParams(keySize));
+    }
+    return "id:" + identityName.toUri();
+  }
+
+  static std::string
+  makeHmacKey()
+  {
+    std::vector<uint8_t> key(32);
+    ndn::random::generateSecureBytes(key);
+
+    namespace tr = ndn::security::transform;
+    std::ostringstream os;
+    tr::bufferSource(key) >> tr::base64Encode(false) >> tr::streamSink(os);
+    return os.str();
+  }
+
+  static std::string
+  makeRandomContent(std::size_t length)
+  {
+    std::uniform_int_distribution<short> dist(std::numeric_limits<char>::min(),
+                                              std::numeric_limits<char>::max());
+    std::string s;
+    s.reserve(length);
+    for (std::size_t i = 0; i < length; i++) {
+      s += static_cast<char>(dist(ndn::random::getRandomNumberEngine()));
+    }
+    return s;
+  }
+
+  /**
+   * @brief Returns the user and system CPU time consumed by the process, in seconds.
+   */
+  static double
+  getCpuTime()
+  {
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    auto toSeconds = [] (const timeval& tv) { return tv.tv_sec + tv.tv_usec / 1e6; };
+    return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+  }
+
+private:
+  const std::chrono::milliseconds m_duration;
+  const bool m_wantFastSigner;
+  const std::string m_hmacKey;
+};
+
+} // namespace ndntg
+
+namespace po = boost::program_options;
+
+static void
+usage(std::ostream& os, std::string_view programName, const po::options_description& desc)
+{
+  os << "Usage: " << programName << " [options]\n"
+     << "\n"
+     << "Measure Data signing throughput across signature types, content sizes and thread counts.\n"
+     << "Keys are generated in memory; the system PIB and TPM are not used.\n"
+     << "\n"
+     << desc;
+}
+
+int
+main(int argc, char* argv[])
+{
+  using ndntg::NdnTrafficSignBench;
+
+  std::vector<std::string> types{"sha256", "hmac", "ecdsa-256", "rsa-2048"};
+  std::vector<std::size_t> contentSizes{100, 1024, 8192};
+  std::vector<unsigned> threadCounts{1};
+  std::string outputFile;
+
+  po::options_description visibleOptions("Options");
+  visibleOptions.add_options()
+    ("help,h",         "print this help message and exit")
+    ("type,t",         po::value<std::vector<std::string>>(&types)->multitoken(),
+                       "signature types: sha256, hmac, ecdsa-256, ecdsa-384, rsa-2048, rsa-3072, rsa-4096 "
+                       "(default: sha256 hmac ecdsa-256 rsa-2048)")
+    ("content-size,s", po::value<std::vector<std::size_t>>(&contentSizes)->multitoken(),
+                       "content sizes in bytes (default: 100 1024 8192)")
+    ("threads,j",      po::value<std::vector<unsigned>>(&threadCounts)->multitoken(),
+                       "numbers of signing threads (default: 1)")
+    ("duration,d",     po::value<std::chrono::milliseconds::rep>()->default_value(2000),
+                       "duration of each measurement in milliseconds")
+    ("fast-signer,f",  po::bool_switch(),
+                       "sign with the precomputed fast path of ndn-traffic-server instead of KeyChain::sign()")
+    ("output,o",       po::value<std::string>(&outputFile), "also write the results to this CSV file")
+    ;
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(visibleOptions).run(), vm);
+    po::notify(vm);
+  }
+  catch (const po::error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+  catch (const boost::bad_any_cast& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 2;
+  }
+
+  if (vm.count("help") > 0) {
+    usage(std::cout, argv[0], visibleOptions);
+    return 0;
+  }
+
+  const auto& supportedTypes = NdnTrafficSignBench::getSupportedTypes();
+  for (const auto& type : types) {
+    if (std::find(supportedTypes.begin(), supportedTypes.end(), type) == supportedTypes.end()) {
+      std::cerr << "ERROR: unsupported signature type '" << type << "'\n";
+      return 2;
+    }
+  }
+
+  if (std::find(threadCounts.begin(), threadCounts.end(), 0) != threadCounts.end()) {
+    std::cerr << "ERROR: the argument for option '--threads' must be positive\n";
+    return 2;
+  }
+
+  std::chrono::milliseconds duration(vm["duration"].as<std::chrono::milliseconds::rep>());
+  if (duration <= std::chrono::milliseconds::zero()) {
+    std::cerr << "ERROR: the argument for option '--duration' must be positive\n";
+    return 2;
+  }
+
+  std::ofstream csv;
+  if (!outputFile.empty()) {
+    csv.open(outputFile, std::ofstream::out | std::ofstream::trunc);
+    if (!csv) {
+      std::cerr << "ERROR: unable to open " << outputFile << std::endl;
+      return 2;
+    }
+    csv << "Type,ContentBytes,Threads,Signatures,Signatures/s,P50(us),P99(us),P999(us),CPU/Signature(us)\n";
+  }
+
+  std::cout << std::left << std::setw(10) << "Type" << std::right
+            << std::setw(10) << "Content" << std::setw(8) << "Threads"
+            << std::setw(14) << "Sigs/s" << std::setw(12) << "p50(us)"
+            << std::setw(12) << "p99(us)" << std::setw(12) << "p99.9(us)"
+            << std::setw(14) << "CPU/sig(us)" << std::endl;
+  std::cout << std::fixed << std::setprecision(1);
+
+  NdnTrafficSignBench bench(duration, vm["fast-signer"].as<bool>());
+  for (const auto& type : types) {
+    for (auto contentSize : contentSizes) {
+      for (auto nThreads : threadCounts) {
+        NdnTrafficSignBench::Result result;
+        try {
+          result = bench.run(type, contentSize, nThreads);
+        }
+        catch (const std::exception& e) {
+          std::cerr << "ERROR: " << type << ": " << e.what() << std::endl;
+          return 1;
+        }
+        double rate = result.nSignatures / result.wallTime;
+        double cpuPerSignature = result.nSignatures > 0 ? result.cpuTime / result.nSignatures * 1e6 : 0.0;
+
+        std::cout << std::left << std::setw(10) << type << std::right
+                  << std::setw(10) << contentSize << std::setw(8) << nThreads
+                  << std::setw(14) << rate
+                  << std::setw(12) << result.latency.getPercentile(50)
+                  << std::setw(12) << result.latency.getPercentile(99)
+                  << std::setw(12) << result.latency.getPercentile(99.9)
+                  << std::setw(14) << cpuPerSignature << std::endl;
+
+        if (csv.is_open()) {
+          csv << type << ',' << contentSize << ',' << nThreads << ',' << result.nSignatures << ','
+              << rate << ',' << result.latency.getPercentile(50) << ','
+              << result.latency.getPercentile(99) << ',' << result.latency.getPercentile(99.9) << ','
+              << cpuPerSignature << '\n';
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_PATTERN_SELECTOR_HPP
+#define NDNTG_PATTERN_SELECTOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define NDNTG_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace ndntg {
+
+/**
+ * @brief Maps a traffic key onto a pattern index using cumulative pattern weights.
+ *
+ * select(key) returns the first index i such that key <= w[0] + ... + w[i], or the number of
+ * patterns if key exceeds the total weight, which is the same result as a linear cumulative scan.
+ *
+ * For up to MAX_SIMD_PATTERNS patterns, the cumulative weights are stored as 32-bit fixed-point
+ * thresholds and compared against the key all at once with SSE2 or AVX2; the index is the number
+ * of thresholds below the key, obtained with movemask and popcount. Larger pattern sets use a
+ * binary search. The implementation is chosen once, when the selector is built.
+ */
+class PatternSelector
+{
+public:
+  static constexpr std::size_t MAX_SIMD_PATTERNS = 64;
+
+  enum class Implementation {
+    BINARY_SEARCH,
+    SCALAR,
+    SSE2,
+    AVX2,
+  };
+
+  void
+  build(const std::vector<double>& weights)
+  {
+    m_cumulative.clear();
+    double cumulative = 0.0;
+    for (double w : weights) {
+      cumulative += w;
+      m_cumulative.push_back(cumulative);
+    }
+
+    m_thresholds.clear();
+    m_implementation = Implementation::BINARY_SEARCH;
+    if (m_cumulative.empty() || m_cumulative.size() > MAX_SIMD_PATTERNS || !(cumulative > 0.0)) {
+      return;
+    }
+
+    // the total weight maps just below UINT32_MAX, the padding lanes use UINT32_MAX
+    m_scale = (static_cast<double>(std::numeric_limits<uint32_t>::max()) - 1.0) / cumulative;
+    m_thresholds.assign((m_cumulative.size() + 7) / 8 * 8, bias(std::numeric_limits<uint32_t>::max()));
+    for (std::size_t i = 0; i < m_cumulative.size(); i++) {
+      m_thresholds[i] = bias(toFixedPoint(m_cumulative[i]));
+    }
+
+    m_implementation = Implementation::SCALAR;
+#ifdef NDNTG_HAVE_X86_SIMD
+    m_implementation = __builtin_cpu_supports("avx2") ? Implementation::AVX2 : Implementation::SSE2;
+#endif
+  }
+
+  Implementation
+  getImplementation() const
+  {
+    return m_implementation;
+  }
+
+  static const char*
+  getImplementationName(Implementation impl)
+  {
+    switch (impl) {
+      case Implementation::BINARY_SEARCH:
+        return "binary search";
+      case Implementation::SCALAR:
+        return "branchless scalar";
+      case Implementation::SSE2:
+        return "SSE2";
+      case Implementation::AVX2:
+        return "AVX2";
+    }
+    return "unknown";
+  }
+
+  std::size_t
+  select(double key) const
+  {
+    if (m_cumulative.empty() || !(key <= m_cumulative.back())) {
+      return m_cumulative.size();
+    }
+
+    std::size_t index = 0;
+    switch (m_implementation) {
+      case Implementation::BINARY_SEARCH:
+        return std::lower_bound(m_cumulative.begin(), m_cumulative.end(), key) - m_cumulative.begin();
+#ifdef NDNTG_HAVE_X86_SIMD
+      case Implementation::SSE2:
+        index = countBelowSse2(bias(toFixedPoint(key)));
+        break;
+      case Implementation::AVX2:
+        index = countBelowAvx2(bias(toFixedPoint(key)));
+        break;
+#endif
+      default:
+        index = countBelowScalar(bias(toFixedPoint(key)));
+        break;
+    }
+
+    // fixed-point rounding can only undercount, when the key is within 1/m_scale above a threshold
+    while (key > m_cumulative[index]) {
+      index++;
+    }
+    return index;
+  }
+
+private:
+  uint32_t
+  toFixedPoint(double value) const
+  {
+    return static_cast<uint32_t>(std::max(value, 0.0) * m_scale);
+  }
+
+  /**
+   * @brief Flips the sign bit, so that unsigned order becomes signed order for SSE/AVX compares.
+   */
+  static int32_t
+  bias(uint32_t value)
+  {
+    return static_cast<int32_t>(value ^ 0x80000000U);
+  }
+
+  std::size_t
+  countBelowScalar(int32_t key) const
+  {
+    std::size_t count = 0;
+    for (int32_t threshold : m_thresholds) {
+      count += threshold < key;
+    }
+    return count;
+  }
+
+#ifdef NDNTG_HAVE_X86_SIMD
+  std::size_t
+  countBelowSse2(int32_t key) const
+  {
+    __m128i k = _mm_set1_epi32(key);
+    int count = 0;
+    for (std::size_t i = 0; i < m_thresholds.size(); i += 4) {
+      __m128i t = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&m_thresholds[i]));
+      count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(k, t))));
+    }
+    return count;
+  }
+
+  __attribute__((target("avx2"))) std::size_t
+  countBelowAvx2(int32_t key) const
+  {
+    __m256i k = _mm256_set1_epi32(key);
+    int count = 0;
+    for (std::size_t i = 0; i < m_thresholds.size(); i += 8) {
+      __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&m_thresholds[i]));
+      count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, t))));
+    }
+    return count;
+  }
+#endif
+
+private:
+  Implementation m_implementation = Implementation::BINARY_SEARCH;
+  std::vector<double> m_cumulative;
+  std::vector<int32_t> m_thresholds; // biased fixed-point cumulative weights, padded to 8 lanes
+  double m_scale = 1.0;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_PATTERN_SELECTOR_HPP
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_SAMPLER_CACHE_HPP
+#define NDNTG_SAMPLER_CACHE_HPP
+
+#include "logger.hpp"
+#include "sketch.hpp"
+
+#include "discrete_distribution_ii.h"
+#include "zipf-mandelbrot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndntg {
+
+/**
+ * @brief On-disk cache of Zipf-Mandelbrot sampler tables.
+ *
+ * Building the alias tables for a catalog of N items costs N std::pow calls and a full
+ * discrete_distribution_30bit::init(), which is minutes of CPU for very large N. The tables
+ * only depend on (s, q, N) and on the weighting function, so they are persisted in a cache
+ * directory and memory-mapped read-only on later runs. Mapped tables are shared through the
+ * page cache by all processes on the same host.
+ */
+class SamplerCache
+{
+public:
+  using ZipfDistribution = rng::zipf_mandelbrot_distribution<rng::discrete_distribution_30bit, int>;
+
+  explicit
+  SamplerCache(std::string directory)
+    : m_directory(std::move(directory))
+  {
+  }
+
+  /**
+   * @brief Returns a Zipf-Mandelbrot distribution over N items, from the cache if possible.
+   *
+   * On a cache miss the distribution is built with @p nThreads threads and stored in the cache.
+   * An empty cache directory disables the cache.
+   */
+  std::unique_ptr<ZipfDistribution>
+  makeZipfMandelbrot(double s, uint32_t q, uint32_t n, unsigned nThreads, Logger& logger) const
+  {
+    // identifies the weighting function and table layout; bump when either changes
+    const uint64_t weightsHash = hashBytes("zipf-mandelbrot/discrete_distribution_30bit/1");
+
+    if (!m_directory.empty()) {
+      auto path = getCacheFilePath(s, q, n, weightsHash);
+      if (auto dd = load(path, s, q, n, weightsHash); dd != nullptr) {
+        logger.log("Sampler tables loaded from cache: " + path.string(), true, false);
+        return std::make_unique<ZipfDistribution>(s, q, n, std::move(dd));
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto dist = std::make_unique<ZipfDistribution>(s, q, n, nThreads);
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+    logger.log("Sampler tables built in " + std::to_string(elapsed.count()) + "s using " +
+               std::to_string(nThreads) + " thread(s)", true, false);
+
+    if (!m_directory.empty()) {
+      auto path = getCacheFilePath(s, q, n, weightsHash);
+      if (store(path, dist->discrete_distribution().tables(), s, q, n, weightsHash)) {
+        logger.log("Sampler tables stored in cache: " + path.string(), true, false);
+      }
+      else {
+        logger.log("WARNING: Unable to store sampler tables in cache: " + path.string(), true, true);
+      }
+    }
+    return dist;
+  }
+
+private:
+  struct FileHeader
+  {
+    char magic[8];
+    uint64_t weightsHash;
+    double s;
+    uint32_t q;
+    uint32_t n;
+    uint32_t byteOrderMark;
+    uint32_t reserved;
+  };
+
+  // file layout: FileHeader, int32 J[256], double V[n], double P[n], int32 K[n]
+  static constexpr char MAGIC[8] = {'N', 'D', 'N', 'T', 'G', 'Z', 'M', '1'};
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+  static constexpr std::size_t TABLES_OFFSET = sizeof(FileHeader) + 256 * sizeof(int32_t);
+
+  static_assert(sizeof(int) == sizeof(int32_t), "sampler tables assume 32-bit int");
+  static_assert(TABLES_OFFSET % alignof(double) == 0, "sampler tables are misaligned");
+
+  static std::size_t
+  getFileSize(uint32_t n)
+  {
+    return TABLES_OFFSET + std::size_t(n) * (2 * sizeof(double) + sizeof(int32_t));
+  }
+
+  std::filesystem::path
+  getCacheFilePath(double s, uint32_t q, uint32_t n, uint64_t weightsHash) const
+  {
+    uint64_t sBits = 0;
+    std::memcpy(&sBits, &s, sizeof(s));
+    uint64_t key = mixHash(mixHash(mixHash(weightsHash ^ sBits) ^ q) ^ n);
+
+    std::ostringstream os;
+    os << "zipf-" << std::hex << key << ".tbl";
+    return std::filesystem::path(m_directory) / os.str();
+  }
+
+  static std::unique_ptr<rng::discrete_distribution_30bit<int>>
+  load(const std::filesystem::path& path, double s, uint32_t q, uint32_t n, uint64_t weightsHash)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) != getFileSize(n)) {
+      ::close(fd);
+      return nullptr;
+    }
+
+    std::size_t size = st.st_size;
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+      return nullptr;
+    }
+    std::shared_ptr<const void> mapping(addr, [size] (const void* p) {
+      ::munmap(const_cast<void*>(p), size);
+    });
+
+    FileHeader header;
+    std::memcpy(&header, addr, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.byteOrderMark != BYTE_ORDER_MARK || header.weightsHash != weightsHash ||
+        header.s != s || header.q != q || header.n != n) {
+      return nullptr;
+    }
+
+    auto base = static_cast<const uint8_t*>(addr);
+    rng::discrete_distribution_30bit<int>::tables_type tables;
+    tables.J = reinterpret_cast<const int*>(base + sizeof(FileHeader));
+    tables.V = reinterpret_cast<const double*>(base + TABLES_OFFSET);
+    tables.P = tables.V + n;
+    tables.K = reinterpret_cast<const int*>(tables.P + n);
+    tables.size = static_cast<int>(n);
+    // a corrupted file of the right size would otherwise make the sampler read out of bounds;
+    // one linear pass is still far cheaper than rebuilding the tables
+    if (!std::all_of(tables.J, tables.J + 256, [n] (int j) { return j >= -1 && j < int64_t(n); }) ||
+        !std::all_of(tables.K, tables.K + n, [n] (int k) { return k >= 0 && k < int64_t(n); })) {
+      return nullptr;
+    }
+    return std::make_unique<rng::discrete_distribution_30bit<int>>(tables, std::move(mapping));
+  }
+
+  static bool
+  store(const std::filesystem::path& path, const rng::discrete_distribution_30bit<int>::tables_type& tables,
+        double s, uint32_t q, uint32_t n, uint64_t weightsHash)
+  {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.weightsHash = weightsHash;
+    header.s = s;
+    header.q = q;
+    header.n = n;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+
+    // write to a temporary file and rename it, so that concurrent readers never see partial tables
+    auto tmpPath = path;
+    tmpPath += "." + std::to_string(::getpid()) + ".tmp";
+    {
+      std::ofstream os(tmpPath, std::ios::binary | std::ios::trunc);
+      os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      os.write(reinterpret_cast<const char*>(tables.J), 256 * sizeof(int32_t));
+      os.write(reinterpret_cast<const char*>(tables.V), std::streamsize(n) * sizeof(double));
+      os.write(reinterpret_cast<const char*>(tables.P), std::streamsize(n) * sizeof(double));
+      os.write(reinterpret_cast<const char*>(tables.K), std::streamsize(n) * sizeof(int32_t));
+      if (!os.flush()) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+      }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+      std::filesystem::remove(tmpPath, ec);
+      return false;
+    }
+    return true;
+  }
+
+private:
+  std::string m_directory;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_SAMPLER_CACHE_HPP
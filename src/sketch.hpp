@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_SKETCH_HPP
+#define NDNTG_SKETCH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace ndntg {
+
+/**
+ * @brief 64-bit FNV-1a hash of a byte string.
+ */
+inline uint64_t
+hashBytes(std::string_view bytes)
+{
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (unsigned char c : bytes) {
+    h ^= c;
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+/**
+ * @brief SplitMix64 finalizer, used to derive independent hashes from one 64-bit hash.
+ */
+inline uint64_t
+mixHash(uint64_t x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @brief Count-Min sketch over 64-bit item hashes.
+ *
+ * Estimates never undercount; with width w and depth d, the overcount is at most
+ * e/w * (total count) with probability 1 - exp(-d).
+ */
+class CountMinSketch
+{
+public:
+  CountMinSketch(std::size_t width, std::size_t depth)
+    : m_width(std::max<std::size_t>(width, 1))
+    , m_depth(std::max<std::size_t>(depth, 1))
+    , m_counters(m_width * m_depth, 0)
+  {
+  }
+
+  /**
+   * @brief Adds @p count occurrences of the item and returns its updated estimate.
+   */
+  uint64_t
+  add(uint64_t itemHash, uint64_t count = 1)
+  {
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (std::size_t row = 0; row < m_depth; row++) {
+      auto& counter = m_counters[row * m_width + getColumn(itemHash, row)];
+      counter += count;
+      estimate = std::min(estimate, counter);
+    }
+    return estimate;
+  }
+
+  uint64_t
+  estimate(uint64_t itemHash) const
+  {
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (std::size_t row = 0; row < m_depth; row++) {
+      estimate = std::min(estimate, m_counters[row * m_width + getColumn(itemHash, row)]);
+    }
+    return estimate;
+  }
+
+  std::size_t
+  getMemoryUsage() const
+  {
+    return m_counters.size() * sizeof(uint64_t);
+  }
+
+private:
+  std::size_t
+  getColumn(uint64_t itemHash, std::size_t row) const
+  {
+    return mixHash(itemHash + row) % m_width;
+  }
+
+private:
+  std::size_t m_width;
+  std::size_t m_depth;
+  std::vector<uint64_t> m_counters;
+};
+
+/**
+ * @brief HyperLogLog estimator of the number of distinct items.
+ *
+ * Uses 2^precision one-byte registers; the standard error is about 1.04 / sqrt(2^precision).
+ * Two estimators with the same precision can be merged.
+ */
+class HyperLogLog
+{
+public:
+  explicit
+  HyperLogLog(unsigned precision = 14)
+    : m_precision(std::clamp(precision, 4U, 18U))
+    , m_registers(std::size_t(1) << m_precision, 0)
+  {
+  }
+
+  void
+  add(uint64_t itemHash)
+  {
+    uint64_t h = mixHash(itemHash);
+    std::size_t index = h >> (64 - m_precision);
+    uint64_t rest = (h << m_precision) | (uint64_t(1) << (m_precision - 1));
+    auto rank = static_cast<uint8_t>(countLeadingZeros(rest) + 1);
+    m_registers[index] = std::max(m_registers[index], rank);
+  }
+
+  void
+  merge(const HyperLogLog& other)
+  {
+    if (other.m_precision != m_precision) {
+      return;
+    }
+    for (std::size_t i = 0; i < m_registers.size(); i++) {
+      m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+    }
+  }
+
+  double
+  estimate() const
+  {
+    double m = static_cast<double>(m_registers.size());
+    double sum = 0.0;
+    std::size_t nZeros = 0;
+    for (auto reg : m_registers) {
+      sum += std::ldexp(1.0, -static_cast<int>(reg));
+      if (reg == 0) {
+        nZeros++;
+      }
+    }
+
+    double alpha = 0.7213 / (1.0 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+    if (raw <= 2.5 * m && nZeros > 0) {
+      // small range correction (linear counting)
+      return m * std::log(m / static_cast<double>(nZeros));
+    }
+    return raw;
+  }
+
+private:
+  static int
+  countLeadingZeros(uint64_t x)
+  {
+    int n = 0;
+    while (n < 64 && (x & (uint64_t(1) << 63)) == 0) {
+      x <<= 1;
+      n++;
+    }
+    return n;
+  }
+
+private:
+  unsigned m_precision;
+  std::vector<uint8_t> m_registers;
+};
+
+/**
+ * @brief Fixed-size set of recently inserted 64-bit item hashes, shared by several threads without locks.
+ *
+ * Open addressing with linear probing over at most MAX_PROBES slots. When they are all taken, the
+ * item overwrites its home slot, so old items are gradually forgotten and the memory stays constant.
+ * An item is thus only detected as a duplicate while it is still in the set.
+ */
+class RecentItemSet
+{
+public:
+  static constexpr std::size_t MAX_PROBES = 8;
+
+  /**
+   * @param capacity number of slots, rounded up to a power of two
+   */
+  explicit
+  RecentItemSet(std::size_t capacity)
+  {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    m_mask = size - 1;
+    // value-initialization zeroes the slots, and zero marks an empty slot
+    m_slots.reset(new std::atomic<uint64_t>[size]());
+  }
+
+  /**
+   * @brief Inserts the item.
+   * @return true if the item was already in the set
+   */
+  bool
+  insert(uint64_t itemHash)
+  {
+    uint64_t key = itemHash | 1;
+    std::size_t home = mixHash(itemHash) & m_mask;
+    for (std::size_t probe = 0; probe < MAX_PROBES; probe++) {
+      auto& slot = m_slots[(home + probe) & m_mask];
+      uint64_t current = slot.load(std::memory_order_relaxed);
+      if (current == 0 && slot.compare_exchange_strong(current, key, std::memory_order_relaxed)) {
+        return false;
+      }
+      if (current == key) {
+        return true;
+      }
+    }
+    m_slots[home].store(key, std::memory_order_relaxed);
+    return false;
+  }
+
+  std::size_t
+  getMemoryUsage() const
+  {
+    return (m_mask + 1) * sizeof(uint64_t);
+  }
+
+private:
+  std::size_t m_mask;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_SKETCH_HPP
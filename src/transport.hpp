@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_TRANSPORT_HPP
+#define NDNTG_TRANSPORT_HPP
+
+#include "batching-transport.hpp"
+
+#include <ndn-cxx/net/face-uri.hpp>
+#include <ndn-cxx/transport/tcp-transport.hpp>
+#include <ndn-cxx/transport/unix-transport.hpp>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+namespace ndntg {
+
+/**
+ * @brief Returns the forwarder URI used when none is given: $NDN_CLIENT_TRANSPORT,
+ *        or the default NFD Unix socket.
+ */
+inline std::string
+getDefaultTransportUri()
+{
+  if (const char* envVar = std::getenv("NDN_CLIENT_TRANSPORT"); envVar != nullptr && *envVar != '\0') {
+    return envVar;
+  }
+#ifdef __APPLE__
+  return "unix:///var/run/nfd/nfd.sock";
+#else
+  return "unix:///run/nfd/nfd.sock";
+#endif
+}
+
+/**
+ * @brief Creates a transport to the forwarder at @p uri.
+ *
+ * Accepts the same URIs as the 'transport' setting of ndn-cxx client.conf,
+ * e.g. unix:///run/nfd/nfd.sock or tcp4://127.0.0.1:6363.
+ * @throw std::invalid_argument the URI scheme is not supported
+ */
+inline std::shared_ptr<ndn::Transport>
+makeTransport(const std::string& uri)
+{
+  if (boost::starts_with(uri, "unix://")) {
+    return ndn::UnixTransport::create(uri);
+  }
+  if (boost::starts_with(uri, "tcp://") || boost::starts_with(uri, "tcp4://") ||
+      boost::starts_with(uri, "tcp6://")) {
+    return ndn::TcpTransport::create(uri);
+  }
+  throw std::invalid_argument("unsupported transport URI '" + uri + "'");
+}
+
+/**
+ * @brief Creates a transport to the forwarder at @p uri that batches its writes.
+ * @throw std::invalid_argument the URI is malformed, cannot be resolved, or its scheme is not supported
+ */
+inline std::shared_ptr<BatchingTransport>
+makeBatchingTransport(const std::string& uri, const BatchingOptions& options)
+{
+  ndn::FaceUri faceUri(uri);
+
+  if (faceUri.getScheme() == "unix") {
+    using Protocol = boost::asio::local::stream_protocol;
+    return std::make_shared<StreamBatchingTransport<Protocol>>(Protocol::endpoint(faceUri.getPath()), options);
+  }
+
+  if (faceUri.getScheme() == "tcp" || faceUri.getScheme() == "tcp4" || faceUri.getScheme() == "tcp6") {
+    using Protocol = boost::asio::ip::tcp;
+    boost::asio::io_context io;
+    Protocol::resolver resolver(io);
+    boost::system::error_code error;
+    auto results = resolver.resolve(faceUri.getHost(), faceUri.getPort().empty() ? "6363" : faceUri.getPort(), error);
+    for (const auto& entry : results) {
+      auto endpoint = entry.endpoint();
+      if ((faceUri.getScheme() == "tcp4" && !endpoint.address().is_v4()) ||
+          (faceUri.getScheme() == "tcp6" && !endpoint.address().is_v6())) {
+        continue;
+      }
+      return std::make_shared<StreamBatchingTransport<Protocol>>(endpoint, options);
+    }
+    throw std::invalid_argument("cannot resolve transport URI '" + uri + "'");
+  }
+
+  throw std::invalid_argument("unsupported transport URI '" + uri + "'");
+}
+
+} // namespace ndntg
+
+#endif // NDNTG_TRANSPORT_HPP
@@ -33,7 +33,7 @@ namespace ndntg {
 inline bool
 extractParameterAndValue(const std::string& input, std::string& parameter, std::string& value)
 {
-  static const std::string allowedCharacters = ":/+._-%";
+  static const std::string allowedCharacters = ":/+._-%@,";
   parameter = "";
   value = "";
 
@@ -94,25 +94,27 @@ readConfigurationFile(const std::string& filename,
     lineNumber++;
     if (std::isalpha(patternLine[0])) {
       TrafficConfigurationType trafficConf;
-      bool shouldSkipLine = false;
-      if (trafficConf.parseConfigurationLine(patternLine, logger, lineNumber)) {
+      bool isValid = trafficConf.parseConfigurationLine(patternLine, logger, lineNumber);
+      if (isValid) {
         while (getline(patternFile, patternLine) && std::isalpha(patternLine[0])) {
           lineNumber++;
           if (!trafficConf.parseConfigurationLine(patternLine, logger, lineNumber)) {
-            shouldSkipLine = true;
+            isValid = false;
             break;
           }
         }
         lineNumber++;
       }
-      else {
-        shouldSkipLine = true;
+      if (!isValid) {
+        // a pattern dropped here would silently shift the IDs of the following ones
+        logger.log("ERROR: Invalid traffic pattern at line " + std::to_string(lineNumber), false, true);
+        return false;
       }
-      if (!shouldSkipLine) {
-        if (trafficConf.checkTrafficDetailCorrectness()) {
-          patterns.push_back(std::move(trafficConf));
-        }
+      if (!trafficConf.checkTrafficDetailCorrectness(logger)) {
+        logger.log("ERROR: Invalid traffic pattern ending at line " + std::to_string(lineNumber), false, true);
+        return false;
       }
+      patterns.push_back(std::move(trafficConf));
     }
   }
 
@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_VALUE_DISTRIBUTION_HPP
+#define NDNTG_VALUE_DISTRIBUTION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ndntg {
+
+/**
+ * @brief Distribution of a non-negative quantity, such as a content size, given in a configuration file.
+ *
+ * The specification is one of:
+ *  - `<value>` or `fixed:<value>`
+ *  - `uniform:<min>:<max>`, over [min, max)
+ *  - `lognormal:<mu>:<sigma>`, the parameters of the underlying normal distribution
+ *  - `pareto:<scale>:<shape>`, with minimum value `scale` and tail index `shape`
+ *  - `empirical:<file>`, a CDF given as `<value> <cumulative probability>` lines in increasing order,
+ *    linearly interpolated between points; empty lines and lines starting with `#` are ignored
+ *
+ * Sampling does not modify the distribution, so one instance can be shared by several threads,
+ * each with its own random engine.
+ */
+class ValueDistribution
+{
+public:
+  explicit
+  ValueDistribution(double value = 0.0)
+    : m_spec(formatValue(value))
+    , m_a(value)
+  {
+  }
+
+  /**
+   * @throw std::invalid_argument the specification is malformed, or the CDF file cannot be read
+   */
+  static ValueDistribution
+  parse(const std::string& spec)
+  {
+    auto colon = spec.find(':');
+    if (colon == std::string::npos) {
+      return ValueDistribution(parseNumber(spec, spec));
+    }
+
+    std::string kind = spec.substr(0, colon);
+    std::string args = spec.substr(colon + 1);
+    ValueDistribution dist;
+    dist.m_spec = spec;
+
+    if (kind == "fixed") {
+      dist.m_a = parseNumber(args, spec);
+    }
+    else if (kind == "uniform") {
+      dist.m_kind = Kind::UNIFORM;
+      parsePair(args, spec, dist.m_a, dist.m_b);
+      if (dist.m_b < dist.m_a) {
+        throw std::invalid_argument("'" + spec + "': maximum is below minimum");
+      }
+    }
+    else if (kind == "lognormal") {
+      dist.m_kind = Kind::LOGNORMAL;
+      parsePair(args, spec, dist.m_a, dist.m_b);
+      if (!(dist.m_b > 0.0)) {
+        throw std::invalid_argument("'" + spec + "': sigma must be positive");
+      }
+    }
+    else if (kind == "pareto") {
+      dist.m_kind = Kind::PARETO;
+      parsePair(args, spec, dist.m_a, dist.m_b);
+      if (!(dist.m_b > 0.0)) {
+        throw std::invalid_argument("'" + spec + "': shape must be positive");
+      }
+    }
+    else if (kind == "empirical") {
+      dist.m_kind = Kind::EMPIRICAL;
+      dist.loadCdf(args);
+    }
+    else {
+      throw std::invalid_argument("'" + spec + "': unknown distribution '" + kind + "'");
+    }
+    return dist;
+  }
+
+  bool
+  isFixed() const
+  {
+    return m_kind == Kind::FIXED;
+  }
+
+  /**
+   * @brief Returns the largest value that can be drawn, or infinity for unbounded distributions.
+   */
+  double
+  getUpperBound() const
+  {
+    switch (m_kind) {
+      case Kind::FIXED:
+        return m_a;
+      case Kind::UNIFORM:
+        return m_b;
+      case Kind::EMPIRICAL:
+        return m_values.back();
+      default:
+        return std::numeric_limits<double>::infinity();
+    }
+  }
+
+  template<typename Engine>
+  double
+  sample(Engine& engine) const
+  {
+    switch (m_kind) {
+      case Kind::FIXED:
+        return m_a;
+      case Kind::UNIFORM:
+        return m_a + drawUnit(engine) * (m_b - m_a);
+      case Kind::LOGNORMAL:
+        return std::exp(m_a + m_b * std::normal_distribution<double>()(engine));
+      case Kind::PARETO:
+        // inverse CDF; 1 - u is in (0, 1], so the result is finite
+        return m_a / std::pow(1.0 - drawUnit(engine), 1.0 / m_b);
+      case Kind::EMPIRICAL:
+        return sampleCdf(drawUnit(engine));
+    }
+    return m_a;
+  }
+
+  /**
+   * @brief Returns the specification the distribution was parsed from.
+   */
+  const std::string&
+  toString() const
+  {
+    return m_spec;
+  }
+
+private:
+  enum class Kind {
+    FIXED,
+    UNIFORM,
+    LOGNORMAL,
+    PARETO,
+    EMPIRICAL,
+  };
+
+  template<typename Engine>
+  static double
+  drawUnit(Engine& engine)
+  {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(engine);
+  }
+
+  static std::string
+  formatValue(double value)
+  {
+    std::ostringstream os;
+    os << value;
+    return os.str();
+  }
+
+  static double
+  parseNumber(const std::string& input, const std::string& spec)
+  {
+    std::size_t end = 0;
+    double value = 0.0;
+    try {
+      value = std::stod(input, &end);
+    }
+    catch (const std::logic_error&) {
+      end = 0;
+    }
+    if (end == 0 || end != input.size() || !(value >= 0.0) || std::isinf(value)) {
+      throw std::invalid_argument("'" + spec + "': '" + input + "' is not a non-negative number");
+    }
+    return value;
+  }
+
+  static void
+  parsePair(const std::string& args, const std::string& spec, double& first, double& second)
+  {
+    auto colon = args.find(':');
+    if (colon == std::string::npos) {
+      throw std::invalid_argument("'" + spec + "': two parameters are required");
+    }
+    first = parseNumber(args.substr(0, colon), spec);
+    second = parseNumber(args.substr(colon + 1), spec);
+  }
+
+  void
+  loadCdf(const std::string& fileName)
+  {
+    std::ifstream file(fileName);
+    if (!file) {
+      throw std::invalid_argument("cannot open CDF file '" + fileName + "'");
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+      lineNumber++;
+      auto first = line.find_first_not_of(" \t\r");
+      if (first == std::string::npos || line[first] == '#') {
+        continue;
+      }
+      std::istringstream is(line);
+      double value = 0.0;
+      double probability = 0.0;
+      if (!(is >> value >> probability) || !(value >= 0.0) || !(probability >= 0.0) ||
+          (!m_values.empty() && (value < m_values.back() || probability < m_probabilities.back()))) {
+        throw std::invalid_argument(fileName + ":" + std::to_string(lineNumber) +
+                                    ": expecting '<value> <cumulative probability>' in increasing order");
+      }
+      m_values.push_back(value);
+      m_probabilities.push_back(probability);
+    }
+
+    if (m_values.empty() || !(m_probabilities.back() > 0.0)) {
+      throw std::invalid_argument("CDF file '" + fileName + "' has no points with a positive probability");
+    }
+    // tolerate CDFs that do not end exactly at 1
+    double total = m_probabilities.back();
+    for (auto& p : m_probabilities) {
+      p /= total;
+    }
+  }
+
+  double
+  sampleCdf(double u) const
+  {
+    auto it = std::lower_bound(m_probabilities.begin(), m_probabilities.end(), u);
+    if (it == m_probabilities.end()) {
+      return m_values.back();
+    }
+    auto i = static_cast<std::size_t>(it - m_probabilities.begin());
+    if (i == 0 || m_probabilities[i] == m_probabilities[i - 1]) {
+      return m_values[i];
+    }
+    double fraction = (u - m_probabilities[i - 1]) / (m_probabilities[i] - m_probabilities[i - 1]);
+    return m_values[i - 1] + fraction * (m_values[i] - m_values[i - 1]);
+  }
+
+private:
+  std::string m_spec;
+  Kind m_kind = Kind::FIXED;
+  double m_a = 0.0;
+  double m_b = 0.0;
+  std::vector<double> m_values;        // EMPIRICAL only
+  std::vector<double> m_probabilities; // EMPIRICAL only, normalized to end at 1
+};
+
+} // namespace ndntg
+
+#endif // NDNTG_VALUE_DISTRIBUTION_HPP
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NDNTG_VALUE_MIX_HPP
+#define NDNTG_VALUE_MIX_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ndntg {
+
+struct WeightedValue
+{
+  uint64_t value = 0;
+  double weight = 1.0;
+};
+
+/**
+ * @brief Weighted set of values of a configuration parameter, such as InterestLifetime.
+ */
+using ValueMix = std::vector<WeightedValue>;
+
+/**
+ * @brief Parses "<value>" or "<value>@<weight>,<value>@<weight>,...", where weights are relative.
+ */
+inline bool
+parseValueMix(const std::string& input, uint64_t maxValue, ValueMix& mix)
+{
+  mix.clear();
+  std::istringstream is(input);
+  std::string item;
+  while (std::getline(is, item, ',')) {
+    auto at = item.find('@');
+    WeightedValue entry;
+    try {
+      std::size_t end = 0;
+      entry.value = std::stoull(item.substr(0, at), &end);
+      if (end != item.substr(0, at).size()) {
+        return false;
+      }
+      if (at != std::string::npos) {
+        entry.weight = std::stod(item.substr(at + 1));
+      }
+    }
+    catch (const std::logic_error&) {
+      return false;
+    }
+    if (entry.value > maxValue || !(entry.weight >= 0.0) || std::isinf(entry.weight)) {
+      return false;
+    }
+    mix.push_back(entry);
+  }
+  return !mix.empty();
+}
+
+inline std::string
+formatValueMix(const ValueMix& mix)
+{
+  if (mix.size() == 1) {
+    return std::to_string(mix.front().value);
+  }
+  std::ostringstream os;
+  for (const auto& entry : mix) {
+    os << (&entry == &mix.front() ? "" : ",") << entry.value << "@" << entry.weight;
+  }
+  return os.str();
+}
+
+} // namespace ndntg
+
+#endif // NDNTG_VALUE_MIX_HPP
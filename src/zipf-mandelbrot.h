@@ -48,6 +48,7 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
@@ -57,6 +58,7 @@
 #include <limits>
 #include <memory>
 #include <random>
+#include <thread>
 #include <tr1/cmath>
 #include <vector>
 
@@ -97,10 +99,14 @@ class zipf_mandelbrot_distribution {
      * 
      * If N=0 (default) the maximum value of N realizeable with a 32 bit
      * unsigned integer given the values of q and s is calculated.
+     *
+     * The N probabilities are computed by nThreads threads; with a single
+     * thread (default) they are summed in rank order.
      */
     explicit zipf_mandelbrot_distribution( const double   s,
                                          const uint32_t q = 0, 
-                                         const uint32_t N = 0 ) : s_(s), 
+                                         const uint32_t N = 0,
+                                         const unsigned nThreads = 1 ) : s_(s), 
                                                                    q_(q), 
                                                                    N_(N),
                                                                    probs_(1) {
@@ -119,22 +125,61 @@ class zipf_mandelbrot_distribution {
 
         probs_.resize( N_, 0 );
 
+        // each thread fills and normalizes one contiguous chunk of ranks
+        unsigned n_chunks = std::max( 1u, std::min( nThreads, N_ / 65536 + 1 ) );
+        std::vector<double> chunk_sums( n_chunks, 0.0 );
+        auto fill_chunk = [this, n_chunks, &chunk_sums]( unsigned c ) {
+            uint32_t first = static_cast<uint32_t>( uint64_t( N_ )*c/n_chunks );
+            uint32_t last = static_cast<uint32_t>( uint64_t( N_ )*( c + 1 )/n_chunks );
+            double sum = 0.0;
+            for ( uint32_t k = first + 1; k < last + 1; ++k ) {
+                double prob = 1.0/std::pow( static_cast<double>( k + q_ ), s_ );
+                sum += prob;
+                probs_[k-1] = prob;
+            }
+            chunk_sums[c] = sum;
+        };
+        run_chunks( n_chunks, fill_chunk );
+
         double p_sum = 0.0;
-        for ( uint32_t k = 1; k < N_+1; ++k ) {
-            double prob = 1.0/std::pow( static_cast<double>( k + q_ ), s_ );
-            p_sum += prob;
-            probs_[k-1] = prob;
-        }
+        for ( double sum : chunk_sums ) p_sum += sum;
 
         double p_norm = 1.0/p_sum;
-        for ( uint32_t i = 0; i < N_; ++i ) {
-            probs_[i] *= p_norm;
-        }
+        run_chunks( n_chunks, [this, n_chunks, p_norm]( unsigned c ) {
+            uint32_t first = static_cast<uint32_t>( uint64_t( N_ )*c/n_chunks );
+            uint32_t last = static_cast<uint32_t>( uint64_t( N_ )*( c + 1 )/n_chunks );
+            for ( uint32_t i = first; i < last; ++i ) {
+                probs_[i] *= p_norm;
+            }
+        });
 
         dd_ = new Discrete_Dist<Int_Type>( probs_.begin(), probs_.end());
 
     }
 
+    /**
+     * Creates a new zipf_mandelbrot_distribution from an already initialized
+     * discrete distribution over the N ranks, taking ownership of it.
+     *
+     * This is used to restore persisted sampler tables without recomputing
+     * the probabilities; probs_ is left empty in that case.
+     */
+    zipf_mandelbrot_distribution( const double   s,
+                                  const uint32_t q,
+                                  const uint32_t N,
+                                  std::unique_ptr<Discrete_Dist<Int_Type>> dd ) : s_(s),
+                                                                                   q_(q),
+                                                                                   N_(N),
+                                                                                   dd_(dd.release()) {
+        if ( dd_ == NULL ) {
+            fprintf( stderr, "no discrete distribution.\n" );
+            abort();
+        }
+    }
+
+    zipf_mandelbrot_distribution( const zipf_mandelbrot_distribution& ) = delete;
+    zipf_mandelbrot_distribution& operator=( const zipf_mandelbrot_distribution& ) = delete;
+
     ~zipf_mandelbrot_distribution() {
         if ( dd_ != NULL ) {
             delete dd_;
@@ -153,6 +198,10 @@ class zipf_mandelbrot_distribution {
         return dd_->probabilities();
     }
 
+    const Discrete_Dist<Int_Type>& discrete_distribution() const {
+        return *dd_;
+    }
+
     result_type min() const { 
         return result_type( 1 );
     }
@@ -163,17 +212,31 @@ class zipf_mandelbrot_distribution {
 
     friend bool operator==( const zipf_mandelbrot_distribution& v1, 
                             const zipf_mandelbrot_distribution& v2) {
-        return v1.probs_ == v2.probs_;
+        return *v1.dd_ == *v2.dd_;
     }
 
     friend bool operator!=( const zipf_mandelbrot_distribution& v1, 
                             const zipf_mandelbrot_distribution& v2) {
-        return !( v1.probs_ == v2.probs_ );
+        return !( *v1.dd_ == *v2.dd_ );
     }
 
 
 private:
 
+    template<typename Function>
+    static void run_chunks( unsigned n_chunks, const Function& f ) {
+        if ( n_chunks == 1 ) {
+            f( 0 );
+            return;
+        }
+        std::vector<std::thread> threads;
+        for ( unsigned c = 1; c < n_chunks; ++c ) {
+            threads.emplace_back( [&f, c]() { f( c ); } );
+        }
+        f( 0 );
+        for ( auto& t : threads ) t.join();
+    }
+
 };
 
 };  // namespace rng
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025, Arizona Board of Regents.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_DYN_LINK
+
+#include "util.hpp"
+#include "value-mix.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+#include <unistd.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace ndntg::tests {
+
+/**
+ * @brief Pattern with the client's InterestLifetime and HopLimit parameters, parsed the same way.
+ */
+class MixConfiguration
+{
+public:
+  bool
+  parseConfigurationLine(const std::string& line, Logger& logger, int lineNumber)
+  {
+    std::string parameter;
+    std::string value;
+    if (!extractParameterAndValue(line, parameter, value)) {
+      logger.log("Line " + std::to_string(lineNumber) + " - Invalid syntax: " + line, false, true);
+      return false;
+    }
+    if (parameter == "Name") {
+      name = value;
+    }
+    else if (parameter == "InterestLifetime") {
+      return parseValueMix(value, std::numeric_limits<int64_t>::max(), interestLifetimes);
+    }
+    else if (parameter == "HopLimit") {
+      return parseValueMix(value, 255, hopLimits);
+    }
+    return true;
+  }
+
+  bool
+  checkTrafficDetailCorrectness(Logger&) const
+  {
+    return true;
+  }
+
+public:
+  std::string name;
+  ValueMix interestLifetimes;
+  ValueMix hopLimits;
+};
+
+class ConfigurationFixture
+{
+protected:
+  ConfigurationFixture()
+    : path(std::filesystem::temp_directory_path() /
+           ("ndntg-configuration-" + std::to_string(::getpid()) + ".conf"))
+  {
+  }
+
+  ~ConfigurationFixture()
+  {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+  }
+
+  bool
+  read(const std::string& contents)
+  {
+    std::ofstream(path) << contents;
+    patterns.clear();
+    return readConfigurationFile(path.string(), patterns, logger);
+  }
+
+protected:
+  std::filesystem::path path;
+  Logger logger{"ConfigurationTest"};
+  std::vector<MixConfiguration> patterns;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestConfiguration, ConfigurationFixture)
+
+BOOST_AUTO_TEST_CASE(WeightedMix)
+{
+  BOOST_REQUIRE(read("Name=/example/A\n"
+                     "InterestLifetime=1000@80,4000@20\n"
+                     "HopLimit=32@1,64@2.5,255\n"
+                     "##########\n"
+                     "Name=/example/B\n"
+                     "InterestLifetime=2000\n"));
+  BOOST_REQUIRE_EQUAL(patterns.size(), 2);
+
+  const auto& lifetimes = patterns[0].interestLifetimes;
+  BOOST_REQUIRE_EQUAL(lifetimes.size(), 2);
+  BOOST_CHECK_EQUAL(lifetimes[0].value, 1000);
+  BOOST_CHECK_EQUAL(lifetimes[0].weight, 80.0);
+  BOOST_CHECK_EQUAL(lifetimes[1].value, 4000);
+  BOOST_CHECK_EQUAL(lifetimes[1].weight, 20.0);
+
+  const auto& hopLimits = patterns[0].hopLimits;
+  BOOST_REQUIRE_EQUAL(hopLimits.size(), 3);
+  BOOST_CHECK_EQUAL(hopLimits[1].value, 64);
+  BOOST_CHECK_EQUAL(hopLimits[1].weight, 2.5);
+  BOOST_CHECK_EQUAL(hopLimits[2].value, 255);
+  BOOST_CHECK_EQUAL(hopLimits[2].weight, 1.0);
+  BOOST_CHECK_EQUAL(formatValueMix(hopLimits), "32@1,64@2.5,255@1");
+
+  BOOST_REQUIRE_EQUAL(patterns[1].interestLifetimes.size(), 1);
+  BOOST_CHECK_EQUAL(formatValueMix(patterns[1].interestLifetimes), "2000");
+}
+
+BOOST_AUTO_TEST_CASE(InvalidMix)
+{
+  // an invalid pattern fails the whole configuration instead of being dropped
+  BOOST_CHECK(!read("Name=/example/A\n"
+                    "HopLimit=32@1,256@1\n"
+                    "##########\n"
+                    "Name=/example/B\n"));
+  BOOST_CHECK(!read("Name=/example/A\n"
+                    "InterestLifetime=1000@x\n"));
+  BOOST_CHECK(!read("Name=/example/A\n"
+                    "InterestLifetime=1000@80;4000@20\n"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestConfiguration
+
+} // namespace ndntg::tests